@@ -0,0 +1,390 @@
+// ZMQBenchmark.cpp :  ZMQMode ӳٻ׼
+//
+// ÷ZMQBenchmark [--mode pair|pubsub|reqrep|pushpull|dealerrouter|all] [--transport inproc|ipc|tcp|shm|all]
+//                    [--sizes 64,1024,16384] [--producers 1,4] [--messages 200000] [--window 1000] [--rate 0] [--reactor N]
+//
+// Linux ڲֿĿ¼ֱӱ룺
+//   g++ -O2 -std=c++17 -pthread -Iinclude bench/ZMQBenchmark.cpp $(ls src/*.cpp | grep -v -e SimpleZeroMQ.cpp -e ZeroMQWrapper.cpp) -lzmq -o zmq_benchmark
+//
+// ģʽpair/pubsub/pushpullϢͷд뷢ʱ̣ն˼㵥ӳ٣
+// ģʽreqrep/dealerrouterɶԶԭԣͳӳ١շͬһڣʱһ¡
+// Ĭϲ٣ʱӳٰŶʱ䣻ӳʱ --rate ÿߵķʡ
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ZMQSocketManager.h"
+#include "LoggerManager.h"
+#include "SocketMetrics.h"
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t kTimestampSize = sizeof(int64_t);
+    constexpr auto kStallTimeout = std::chrono::seconds(2);  // ôûϢΪʣѶʧ
+
+    struct BenchOptions {
+        std::vector<std::string> modes{ "pair", "pubsub", "reqrep", "pushpull", "dealerrouter" };
+        std::vector<std::string> transports{ "inproc", "ipc", "tcp", "shm" };  // shm ֻ pushpull
+        std::vector<size_t> sizes{ 64, 1024, 16384 };
+        std::vector<size_t> producers{ 1, 4 };
+        size_t messages = 200000;
+        size_t window = 1000;  // dealerrouter ÿߵ;
+        size_t rate = 0;       // ÿÿ뷢͵Ϣ0 ʾ
+        size_t reactor_threads = 0;
+    };
+
+    struct BenchResult {
+        size_t sent = 0;
+        size_t received = 0;
+        double seconds = 0;
+        LatencySnapshot latency;
+    };
+
+    int64_t NowNanos()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    std::vector<uint8_t> MakePayload(size_t size)
+    {
+        std::vector<uint8_t> payload((std::max)(size, kTimestampSize), 0xAB);
+        int64_t now = NowNanos();
+        std::memcpy(payload.data(), &now, kTimestampSize);
+        return payload;
+    }
+
+    // ԤϢʱΪ 0
+    std::vector<uint8_t> MakeWarmup(size_t size)
+    {
+        std::vector<uint8_t> payload((std::max)(size, kTimestampSize), 0);
+        return payload;
+    }
+
+    int64_t ReadTimestamp(ByteView data)
+    {
+        int64_t sent_at = 0;
+        if (data.size() >= kTimestampSize)
+            std::memcpy(&sent_at, data.data(), kTimestampSize);
+        return sent_at;
+    }
+
+    std::string MakeAddress(const std::string& transport, int index)
+    {
+        if (transport == "inproc")
+            return "inproc://zmqbench-" + std::to_string(index);
+        if (transport == "ipc")
+            return "ipc://zmqbench-" + std::to_string(index) + ".ipc";
+        if (transport == "shm")
+            return ZMQEndpoint::shm("zmqbench-" + std::to_string(index));
+        return "tcp://127.0.0.1:" + std::to_string(19000 + index);
+    }
+
+    // ն˹õļӳͳ
+    struct Receiver {
+        std::atomic<size_t> received{ 0 };
+        std::atomic<bool> warmed_up{ false };
+        std::atomic<int64_t> last_receive{ 0 };
+        LatencyHistogram latency;
+
+        void on_message(ByteView data)
+        {
+            int64_t sent_at = ReadTimestamp(data);
+            if (sent_at == 0) {
+                warmed_up = true;
+                return;
+            }
+            int64_t now = NowNanos();
+            latency.record(static_cast<uint64_t>((std::max<int64_t>)(now - sent_at, 0)));
+            last_receive.store(now, std::memory_order_relaxed);
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // ȵʱûнչ
+        void wait_for(size_t expected)
+        {
+            size_t last_count = 0;
+            auto last_progress = Clock::now();
+            while (received.load() < expected) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                size_t count = received.load();
+                if (count != last_count) {
+                    last_count = count;
+                    last_progress = Clock::now();
+                }
+                else if (Clock::now() - last_progress > kStallTimeout) {
+                    break;
+                }
+            }
+        }
+    };
+
+    //  pub/sub С롱ģʽϷԤϢֱԶյ
+    template <typename SendFn>
+    bool WarmUp(Receiver& receiver, size_t size, SendFn send)
+    {
+        auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (!receiver.warmed_up && Clock::now() < deadline) {
+            send(MakeWarmup(size));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        // òԤϢȱ
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return receiver.warmed_up;
+    }
+
+    template <typename SendFn>
+    size_t RunProducers(size_t producers, size_t messages, size_t size, size_t rate, SendFn send)
+    {
+        std::atomic<size_t> sent{ 0 };
+        std::vector<std::thread> threads;
+        size_t per_producer = messages / producers;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p]() {
+                size_t count = per_producer + (p == 0 ? messages % producers : 0);
+                auto interval = rate > 0 ? std::chrono::nanoseconds(1000000000 / rate) : std::chrono::nanoseconds(0);
+                auto next_send = Clock::now();
+                for (size_t i = 0; i < count; ++i) {
+                    if (rate > 0) {
+                        while (Clock::now() < next_send)
+                            std::this_thread::yield();
+                        next_send += interval;
+                    }
+                    if (send(MakePayload(size)))
+                        sent.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        return sent.load();
+    }
+
+    BenchResult Finish(Receiver& receiver, size_t sent, int64_t start)
+    {
+        receiver.wait_for(sent);
+
+        BenchResult result;
+        result.sent = sent;
+        result.received = receiver.received.load();
+        int64_t end = receiver.last_receive.load();
+        result.seconds = end > start ? (end - start) / 1e9 : 0;
+        result.latency = receiver.latency.snapshot();
+        return result;
+    }
+
+    // ģʽsender  send(payload) ͣreceiver ͨ attach(receiver) 
+    BenchResult RunOneWay(const std::string& mode, const std::string& address, size_t size, size_t producers, size_t messages, size_t rate)
+    {
+        Receiver receiver;
+        std::unique_ptr<ZMQSocketManager> sender;
+        std::unique_ptr<ZMQSocketManager> receiving;
+
+        if (mode == "pair") {
+            sender = std::make_unique<ZMQSocketManager>(ZMQMode::Pair, address, "");
+            receiving = std::make_unique<ZMQSocketManager>(ZMQMode::Pair, "", address);
+            receiving->set_view_callback([&receiver](ByteView data) { receiver.on_message(data); });
+        }
+        else if (mode == "pushpull") {
+            sender = std::make_unique<ZMQSocketManager>(ZMQMode::PushPull, address, "");
+            receiving = std::make_unique<ZMQSocketManager>(ZMQMode::PushPull, "", address);
+            receiving->set_view_callback([&receiver](ByteView data) { receiver.on_message(data); });
+        }
+        else {
+            sender = std::make_unique<ZMQSocketManager>(ZMQMode::PubSub, address, "");
+            receiving = std::make_unique<ZMQSocketManager>(ZMQMode::PubSub, "", address, "");
+            receiving->set_sub_view_callback([&receiver](std::string_view, ByteView data) { receiver.on_message(data); });
+        }
+
+        bool pubsub = mode == "pubsub";
+        auto send = [&](std::vector<uint8_t>&& payload) {
+            return pubsub ? sender->send_sub_async(std::move(payload), "bench") : sender->send_async(std::move(payload));
+        };
+
+        if (!WarmUp(receiver, size, send)) {
+            std::cerr << "warm-up failed for " << mode << " " << address << std::endl;
+            return BenchResult();
+        }
+
+        int64_t start = NowNanos();
+        size_t sent = RunProducers(producers, messages, size, rate, send);
+        return Finish(receiver, sent, start);
+    }
+
+    BenchResult RunReqRep(const std::string& address, size_t size, size_t producers, size_t messages, size_t rate)
+    {
+        Receiver receiver;
+        ZMQSocketManager replier(ZMQMode::ReqRep, "", address);
+        replier.set_view_callback([&replier](ByteView data) { replier.send_replier_reply(data.to_vector()); });
+        ZMQSocketManager requester(ZMQMode::ReqRep, address, "");
+        requester.set_view_callback([&receiver](ByteView data) { receiver.on_message(data); });
+
+        if (!WarmUp(receiver, size, [&](std::vector<uint8_t>&& payload) { return requester.send_async(std::move(payload)); })) {
+            std::cerr << "warm-up failed for reqrep " << address << std::endl;
+            return BenchResult();
+        }
+
+        int64_t start = NowNanos();
+        size_t sent = RunProducers(producers, messages, size, rate,
+            [&](std::vector<uint8_t>&& payload) { return requester.send_async(std::move(payload)); });
+        return Finish(receiver, sent, start);
+    }
+
+    BenchResult RunDealerRouter(const std::string& address, size_t size, size_t producers, size_t messages, size_t window, size_t rate)
+    {
+        Receiver receiver;
+        ZMQSocketManager router(ZMQMode::DealerRouter, "", address);
+        router.set_router_request_callback([&router](ByteView id, uint64_t correlation_id, ByteView data) {
+            router.send_router_reply(id.to_vector(), correlation_id, data.to_vector());
+            });
+        ZMQSocketManager dealer(ZMQMode::DealerRouter, address, "");
+
+        std::atomic<size_t> in_flight{ 0 };
+        size_t max_in_flight = window * producers;
+        auto on_reply = [&](uint64_t, RequestStatus status, ByteView data) {
+            in_flight.fetch_sub(1, std::memory_order_relaxed);
+            if (status == RequestStatus::Ok)
+                receiver.on_message(data);
+        };
+        auto send = [&](std::vector<uint8_t>&& payload) {
+            // ;ȫһѹ
+            while (in_flight.load(std::memory_order_relaxed) >= max_in_flight)
+                std::this_thread::yield();
+            in_flight.fetch_add(1, std::memory_order_relaxed);
+            if (dealer.request_async(payload, on_reply, std::chrono::seconds(10)) == 0) {
+                in_flight.fetch_sub(1, std::memory_order_relaxed);
+                return false;
+            }
+            return true;
+        };
+
+        if (!WarmUp(receiver, size, send)) {
+            std::cerr << "warm-up failed for dealerrouter " << address << std::endl;
+            return BenchResult();
+        }
+
+        int64_t start = NowNanos();
+        size_t sent = RunProducers(producers, messages, size, rate, send);
+        return Finish(receiver, sent, start);
+    }
+
+    void PrintHeader()
+    {
+        std::printf("%-13s %-7s %7s %5s %9s %9s %12s %9s %9s %9s %9s\n",
+            "mode", "trans", "size", "prod", "sent", "recv", "msgs/s", "MB/s", "p50(us)", "p99(us)", "p99.9(us)");
+    }
+
+    void PrintResult(const std::string& mode, const std::string& transport, size_t size, size_t producers, const BenchResult& result)
+    {
+        double rate = result.seconds > 0 ? result.received / result.seconds : 0;
+        double mbps = rate * (std::max)(size, kTimestampSize) / (1024.0 * 1024.0);
+        std::printf("%-13s %-7s %7zu %5zu %9zu %9zu %12.0f %9.1f %9.1f %9.1f %9.1f\n",
+            mode.c_str(), transport.c_str(), size, producers, result.sent, result.received, rate, mbps,
+            result.latency.p50_ns / 1e3, result.latency.p99_ns / 1e3, result.latency.p999_ns / 1e3);
+        std::fflush(stdout);
+    }
+
+    template <typename T, typename Parse>
+    std::vector<T> SplitList(const std::string& text, Parse parse)
+    {
+        std::vector<T> values;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (!item.empty())
+                values.push_back(parse(item));
+        }
+        return values;
+    }
+
+    bool ParseOptions(int argc, char* argv[], BenchOptions& options)
+    {
+        auto to_size = [](const std::string& s) { return static_cast<size_t>(std::stoull(s)); };
+        auto to_string = [](const std::string& s) { return s; };
+
+        for (int i = 1; i + 1 < argc; i += 2) {
+            std::string key = argv[i];
+            std::string value = argv[i + 1];
+            if (key == "--mode" && value != "all")
+                options.modes = SplitList<std::string>(value, to_string);
+            else if (key == "--transport" && value != "all")
+                options.transports = SplitList<std::string>(value, to_string);
+            else if (key == "--sizes")
+                options.sizes = SplitList<size_t>(value, to_size);
+            else if (key == "--producers")
+                options.producers = SplitList<size_t>(value, to_size);
+            else if (key == "--messages")
+                options.messages = to_size(value);
+            else if (key == "--window")
+                options.window = to_size(value);
+            else if (key == "--rate")
+                options.rate = to_size(value);
+            else if (key == "--reactor")
+                options.reactor_threads = to_size(value);
+            else if (key != "--mode" && key != "--transport")
+                return false;
+        }
+        return argc % 2 == 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: ZMQBenchmark [--mode pair|pubsub|reqrep|pushpull|dealerrouter|all] [--transport inproc|ipc|tcp|shm|all]"
+            " [--sizes 64,1024] [--producers 1,4] [--messages N] [--window N] [--rate N] [--reactor N]" << std::endl;
+        return 1;
+    }
+
+    LoggerManager::Init();
+    LoggerManager::SetLevel(spdlog::level::warn);
+    if (options.reactor_threads > 0)
+        ZMQSocketManager::enable_reactor_mode(options.reactor_threads);
+
+    PrintHeader();
+    int endpoint_index = 0;
+    for (const auto& mode : options.modes) {
+        for (const auto& transport : options.transports) {
+            for (size_t size : options.sizes) {
+                for (size_t producers : options.producers) {
+                    if (producers == 0 || (transport == "shm" && mode != "pushpull"))
+                        continue;
+
+                    // Ϣֽⶥreqrep һֻһ;Ϣٵʮ֮һ
+                    size_t messages = (std::min)(options.messages, (size_t(1) << 30) / (std::max)(size, kTimestampSize));
+                    if (mode == "reqrep")
+                        messages = (std::max<size_t>)(messages / 10, 1);
+                    messages = (std::max)(messages, producers);
+
+                    std::string address = MakeAddress(transport, endpoint_index++);
+                    BenchResult result;
+                    if (mode == "reqrep")
+                        result = RunReqRep(address, size, producers, messages, options.rate);
+                    else if (mode == "dealerrouter")
+                        result = RunDealerRouter(address, size, producers, messages, options.window, options.rate);
+                    else if (mode == "pair" || mode == "pubsub" || mode == "pushpull")
+                        result = RunOneWay(mode, address, size, producers, messages, options.rate);
+                    else {
+                        std::cerr << "unknown mode: " << mode << std::endl;
+                        return 1;
+                    }
+
+                    PrintResult(mode, transport, size, producers, result);
+                    if (transport == "shm")
+                        SharedMemoryRing::remove(ZMQEndpoint::path(address));
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <zmq.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// ӵݵֽͼĿʹ C++17û std::span
+// ջص ByteView ֻڻصִڼЧҪʱ to_vector
+class ByteView {
+public:
+    ByteView() : data_(nullptr), size_(0) {}
+    ByteView(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    ByteView(const std::vector<uint8_t>& data) : data_(data.data()), size_(data.size()) {}
+    explicit ByteView(const zmq::message_t& msg)
+        : data_(static_cast<const uint8_t*>(msg.data())), size_(msg.size()) {}
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+    uint8_t operator[](size_t index) const { return data_[index]; }
+
+    std::vector<uint8_t> to_vector() const { return std::vector<uint8_t>(begin(), end()); }
+    std::string_view as_string() const { return std::string_view(reinterpret_cast<const char*>(data_), size_); }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ջص˳֤
+enum class DispatchOrdering {
+    Unordered = 0,  // й̹߳һУ֤˳
+    PerIdentity,    // ͬһ Router identity Ϣ˳ִ
+    PerTopic        // ͬһ topic Ϣ˳ִ
+};
+
+struct DispatchOptions {
+    size_t threads = 0;  // 0 ʾʹ̳߳أصֱ socket  I/O ִ߳
+    DispatchOrdering ordering = DispatchOrdering::Unordered;
+};
+
+// ջصĹ̳߳أʹʱĻص socket շ
+// ģʽ° key ̶䵽ĳ̣߳ͬ key Уͬ key Уģʽ¹һ
+class CallbackExecutor
+{
+public:
+    using Task = std::function<void()>;
+
+    CallbackExecutor(size_t thread_count, DispatchOrdering ordering);
+    ~CallbackExecutor();
+
+    // ģʽ key
+    void submit(size_t key, Task task);
+
+    // ִύֹ֮ͣύ񱻶 droppedڻص̣߳е
+    void stop();
+
+    DispatchOrdering ordering() const { return ordering_; }
+    size_t size() const { return threads_.size(); }
+    size_t pending() const;
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct TaskQueue {
+        mutable std::mutex mutex;
+        std::condition_variable not_empty;
+        std::deque<Task> tasks;
+        bool stopped = false;
+    };
+
+    void worker_loop(TaskQueue& queue);
+
+    DispatchOrdering ordering_;
+    std::vector<std::unique_ptr<TaskQueue>> queues_;  // ģʽֻһ
+    std::vector<std::thread> threads_;
+    std::once_flag stop_once_;
+    std::atomic<uint64_t> dropped_;
+};
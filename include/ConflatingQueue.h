@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//  topic ϲķͶУͬһ topic δȡߵϢϢԭ滻гȲ topic 
+//  topic һӵȺ˳ȡT Ҫ std::string topic Ա
+// ߳ pushI/O ߳ drain
+template <typename T>
+class ConflatingQueue
+{
+public:
+    //  true ʾ滻ͬһ topic ľϢ
+    bool push(T item)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(item.topic);
+        if (it != index_.end()) {
+            items_[it->second] = std::move(item);
+            ++replaced_;
+            return true;
+        }
+
+        index_.emplace(item.topic, items_.size());
+        items_.push_back(std::move(item));
+        return false;
+    }
+
+    // һȡȫϢ׷ӵ outȡ
+    size_t drain(std::deque<T>& out)
+    {
+        std::vector<T> items;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items.swap(items_);
+            index_.clear();
+        }
+
+        for (auto& item : items)
+            out.push_back(std::move(item));
+        return items.size();
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.empty();
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    uint64_t replaced() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return replaced_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<T> items_;
+    std::unordered_map<std::string, size_t> index_;  // topic -> items_ е±
+    uint64_t replaced_ = 0;
+};
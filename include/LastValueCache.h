@@ -0,0 +1,41 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// ÿ topic һηϢ弰 topic ţ I/O ߳д룬̶߳ȡ
+//  zmq::message_t Ĺ libzmq СϢֵݰüٸһ
+class LastValueCache
+{
+public:
+    struct Entry {
+        std::string topic;
+        uint64_t sequence;
+        zmq::message_t value;
+    };
+
+    // ¼ topic ֵţÿ topic  1 ʼmsg ᱻΪ֮Կճ
+    uint64_t update(const std::string& topic, zmq::message_t& msg);
+
+    // ȡ topic ֵûʱ false
+    bool get(const std::string& topic, zmq::message_t& out, uint64_t* sequence = nullptr) const;
+
+    //  prefix ͷ topic ĵǰֵ SUB ĶĹ˹һ
+    std::vector<Entry> snapshot(std::string_view prefix) const;
+
+    size_t size() const;
+
+private:
+    struct Value {
+        uint64_t sequence = 0;
+        zmq::message_t message;
+    };
+
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<std::string, Value> values_;  // copy Ҫ const ԴϢ
+};
@@ -1,14 +1,70 @@
 #pragma once
 
+// ־𣺵ڸü·־ZMQ_HOT_* SPDLOG_* ֱӱ
+// ڹ̵Ԥиǣ SPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_WARN
+#ifndef SPDLOG_ACTIVE_LEVEL
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#endif
+
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+struct LoggerOptions {
+    bool async = false;                  // 첽ģʽ־Ƚн绷ζУɺ̨߳д
+    size_t async_queue_size = 8192;      // 첽
+    bool async_block_when_full = false;  // ʱ÷Ĭϸɵ־շ߳
+    spdlog::level::level_enum flush_level = spdlog::level::debug;  // ﵽüˢ
+    uint32_t sample_rate = 1;            // ·־ÿ N  1 
+};
+
 class LoggerManager
 {
 public:
-    static void Init();
+    // ֻеһεЧҪ첽ģʽʱӦڴκ֮ͨǰ
+    static void Init(const LoggerOptions& options = LoggerOptions());
     static void SetLevel(spdlog::level::level_enum level);
+
+    // ·־ʣ<= 1 ʾ
+    static void SetSampleRate(uint32_t every_n);
+    static bool Sample(std::atomic<uint32_t>& counter)
+    {
+        uint32_t rate = sample_rate_.load(std::memory_order_relaxed);
+        return rate <= 1 || counter.fetch_add(1, std::memory_order_relaxed) % rate == 0;
+    }
+
+private:
+    static inline std::atomic<uint32_t> sample_rate_{ 1 };
 };
+
+// ÿϢִе־ȼڼͲֵ HexUtils::BytesToHex
+#define ZMQ_HOT_LOG(level, ...)                                                        \
+    do {                                                                               \
+        if (spdlog::default_logger_raw()->should_log(level)) {                         \
+            static std::atomic<uint32_t> zmq_hot_log_counter{ 0 };                     \
+            if (LoggerManager::Sample(zmq_hot_log_counter))                            \
+                spdlog::default_logger_raw()->log(level, __VA_ARGS__);                 \
+        }                                                                              \
+    } while (0)
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define ZMQ_HOT_DEBUG(...) ZMQ_HOT_LOG(spdlog::level::debug, __VA_ARGS__)
+#else
+#define ZMQ_HOT_DEBUG(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define ZMQ_HOT_INFO(...) ZMQ_HOT_LOG(spdlog::level::info, __VA_ARGS__)
+#else
+#define ZMQ_HOT_INFO(...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define ZMQ_HOT_WARN(...) ZMQ_HOT_LOG(spdlog::level::warn, __VA_ARGS__)
+#else
+#define ZMQ_HOT_WARN(...) (void)0
+#endif
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PacketBuilder.h"
+#include "ByteView.h"
+
+struct PacketBatchOptions {
+    size_t max_batch_bytes = 16 * 1024;             // ۼƴﵽôС
+    std::chrono::microseconds linger{ 200 };        // һȴʱ
+};
+
+// Ѷ PacketBuilder ʽСƴͬһ֡ͣ libzmq 뷢Ͷе
+// ֡ʽɸ [][][] βӣ֡ҲǺϷնͳһ PacketReader 
+class PacketBatcher
+{
+public:
+    // sink ͨ [&](std::vector<uint8_t>&& frame) { return channel.send_async(std::move(frame)); }
+    // ڵ add/flush ̻߳ڲ linger ߳ϵãͬһʱֻһ
+    using FrameSink = std::function<bool(std::vector<uint8_t>&& frame)>;
+
+    explicit PacketBatcher(FrameSink sink, const PacketBatchOptions& options = PacketBatchOptions());
+    ~PacketBatcher();  // ʣİ
+
+    // ̰߳ȫ false ʾ sink ܾ򱾴 add һ
+    bool add(PayloadType type, const uint8_t* payload, size_t size);
+    bool add(PayloadType type, ByteView payload) { return add(type, payload.data(), payload.size()); }
+
+    // ۼƵİ
+    bool flush();
+
+    uint64_t packets_sent() const { return packets_sent_.load(std::memory_order_relaxed); }
+    uint64_t batches_sent() const { return batches_sent_.load(std::memory_order_relaxed); }
+    uint64_t packets_dropped() const { return packets_dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void linger_loop();
+
+    FrameSink sink_;
+    PacketBatchOptions options_;
+
+    std::mutex mutex_;  //  buffer_  packet_count_
+    std::condition_variable first_packet_;
+    std::vector<uint8_t> buffer_;
+    size_t packet_count_;
+    std::chrono::steady_clock::time_point deadline_;
+
+    std::mutex flush_mutex_;  // ֤˳򽻸 sink
+
+    std::atomic<uint64_t> packets_sent_;
+    std::atomic<uint64_t> batches_sent_;
+    std::atomic<uint64_t> packets_dropped_;
+
+    bool running_;
+    std::thread linger_thread_;
+};
+
+// ͵رһ֡еа
+// ÷PacketReader reader(frame); PayloadType type; ByteView payload; while (reader.next(type, payload)) { ... }
+class PacketReader
+{
+public:
+    explicit PacketReader(ByteView frame) : frame_(frame), offset_(0), error_(false) {}
+
+    bool next(PayloadType& type, ByteView& payload)
+    {
+        if (offset_ >= frame_.size())
+            return false;
+
+        ByteView rest(frame_.data() + offset_, frame_.size() - offset_);
+        if (!PacketBuilder::TryParsePacket(rest, type, payload)) {
+            // ֡βֹͣ
+            error_ = true;
+            offset_ = frame_.size();
+            return false;
+        }
+
+        offset_ += PacketBuilder::kHeaderSize + payload.size();
+        return true;
+    }
+
+    // Ϊ true ʾ֡޷ʣֽ
+    bool error() const { return error_; }
+
+private:
+    ByteView frame_;
+    size_t offset_;
+    bool error_;
+};
@@ -1,6 +1,10 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
 #include <vector>
+#include <zmq.hpp>
+
+#include "ByteView.h"
 
 enum class PayloadType : uint8_t {
     RawBytes = 0x01,
@@ -12,10 +16,27 @@ enum class PayloadType : uint8_t {
 class PacketBuilder
 {
 public:
+    static constexpr size_t kHeaderSize = 5;
+
     //  + 4ֽڳȣСˣ+ 
     static std::vector<uint8_t> BuildPacket(PayloadType type, const std::vector<uint8_t>& payload);
 
     // ȡͺ
     static bool TryParsePacket(const std::vector<uint8_t>& packet, PayloadType& type, std::vector<uint8_t>& payload);
-};
 
+    // Ϊİ汾
+
+    // ֻд 5 ֽڰͷout  kHeaderSize ֽ
+    static void EncodeHeader(PayloadType type, uint32_t payload_length, uint8_t* out);
+
+    // ԤͷĻ kHeaderSize ʼдд FinalizePacket ͵زϰͷ
+    //  send_async(std::move(packet)) 㿽
+    static std::vector<uint8_t> AllocatePacket(size_t payload_size);
+    static bool FinalizePacket(PayloadType type, std::vector<uint8_t>& packet);
+
+    // ֱӷΪ zmq::message_tֻһ
+    static zmq::message_t BuildMessage(PayloadType type, const uint8_t* payload, size_t size);
+
+    // Ϊͼpayload ָ packet ڲЧ packet ͬ
+    static bool TryParsePacket(ByteView packet, PayloadType& type, ByteView& payload);
+};
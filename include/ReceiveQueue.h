@@ -0,0 +1,55 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "SPSCRingBuffer.h"
+
+// ȡģʽĽնУI/O ̰߳յϢŽ SPSC ÷Լ߳ȡߣٻص
+// һLinux Ϊ eventfdWindows Ϊֶõ Eventзǿʱź״̬
+// ÷Լһȴȡնʱ front / wait Զλ÷Ҫжȡλ
+// ֻһ socket  I/O ̣߳ͬһʱҲֻһ߳
+class ReceiveQueue
+{
+public:
+    struct Entry {
+        std::string key;       // PubSub Ϊ topicRouter ΪԶ identityģʽΪ
+        zmq::message_t data;
+    };
+
+    // ʧʱ׳ std::runtime_error
+    explicit ReceiveQueue(size_t capacity);
+    ~ReceiveQueue();
+
+    ReceiveQueue(const ReceiveQueue&) = delete;
+    ReceiveQueue& operator=(const ReceiveQueue&) = delete;
+
+    // ߣʱϢI/O ̲߳
+    bool push(std::string_view key, zmq::message_t&& data);
+
+    // ߣпʱ nullptr λصĿ pop ֮ǰЧ
+    Entry* front();
+    void pop();
+
+    // ߣȴзǿգtimeout Ϊʾһֱȴ false ʾʱ
+    bool wait(std::chrono::milliseconds timeout);
+
+    // Linux ΪļWindows Ϊ HANDLE
+    intptr_t ready_handle() const { return handle_; }
+
+    size_t size_approx() const { return ring_.size_approx(); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void signal();
+    void rearm();  // ߷ֶпʱãλ󸴲飬 push ʱź
+
+    SPSCRingBuffer<Entry> ring_;
+    intptr_t handle_;
+    std::atomic<bool> signaled_;
+    std::atomic<uint64_t> dropped_;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ÿ topic  depth ѷϢȡģŽ̶СĻĶ˷ȱʱﲹ
+//  zmq::message_t Ĺֻڷ I/O ߳Ϸʣ
+class RetransmitBuffer
+{
+public:
+    struct Entry {
+        uint64_t sequence;
+        zmq::message_t value;
+    };
+
+    explicit RetransmitBuffer(size_t depth);
+
+    // msg ᱻΪ֮Կճ
+    void store(const std::string& topic, uint64_t sequence, zmq::message_t& msg);
+
+    // ˳׷ [from, to] ڻϢѱǵֱ
+    void collect(const std::string& topic, uint64_t from, uint64_t to, std::vector<Entry>& out);
+
+    size_t depth() const { return depth_; }
+
+private:
+    struct Slot {
+        uint64_t sequence = 0;
+        zmq::message_t message;
+    };
+
+    size_t depth_;
+    std::unordered_map<std::string, std::vector<Slot>> rings_;  // ÿ topic һηʱ
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ByteView.h"
+
+// ROUTER Զ identity վӳ䣺Ѱַ̽⣬ɾʱƣ+ ʽ
+// ʱ̭ûϢĶԶˣ÷ȷ֪Զ뿪ʱ evict Ƴ
+// ZMQ_ROUTER_NOTIFY ĶϿ֪ͨ [id][֡] Զĵ֡޷֣յ֡ʱֻ retire
+// ѶԶŵ̭λãʹʧЧԶߣһϢƻرͷ
+// λĿ±ꡢλǴĿ̭ɾʧЧ󷢸øĿ¶Զ
+// ̵߳Ǽǣ߳̽
+class RouterIdentityTable
+{
+public:
+    using Handle = uint32_t;
+    static constexpr Handle kInvalidHandle = 0;
+    static constexpr size_t kMaxCapacity = size_t(1) << 20;
+
+    explicit RouterIdentityTable(size_t capacity = 16384);
+
+    // һǼ identity Ϊֻ֣¶Զ˻Ḵһ identityĿʱеĻ
+    Handle intern(ByteView identity);
+
+    // ֻҲǼǣδ֪Զ˷ kInvalidHandle
+    Handle find(ByteView identity) const;
+
+    // ȡӦ identityʧЧʱ falseidentity  libzmq СϢֵʱڴ
+    bool resolve(Handle handle, zmq::message_t& out) const;
+    bool resolve(Handle handle, std::vector<uint8_t>& out) const;
+
+    // ƳԶˣ֮ľʧЧٴγʱ¾
+    void evict(ByteView identity);
+
+    // ѶԶƵ̭˳ǰ棬Чֱ̭
+    void retire(Handle handle);
+
+    size_t size() const;
+    size_t capacity() const { return entries_.size(); }
+
+private:
+    static constexpr uint32_t kIndexBits = 20;
+    static constexpr uint32_t kIndexMask = (uint32_t(1) << kIndexBits) - 1;
+    static constexpr uint32_t kNone = UINT32_MAX;
+
+    struct Entry {
+        std::string identity;
+        uint64_t hash = 0;
+        uint32_t generation = 1;  // ֻ kIndexBits ֮λϻƣ 0֤Ϊ kInvalidHandle
+        uint32_t prev = kNone;    // ͷ
+        uint32_t next = kNone;
+        bool used = false;
+    };
+
+    static uint64_t hash_of(ByteView identity);
+    Handle handle_of(uint32_t index) const;
+    const Entry* entry_of(Handle handle) const;
+
+    uint32_t lookup(ByteView identity, uint64_t hash) const;  // Ŀ±꣬ҲʱΪ kNone
+    void remove(uint32_t index);
+    void unlink(uint32_t index);
+    void push_front(uint32_t index);
+
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> buckets_;  // Ŀ±꣬kNone ΪգΪ 2 ҲĿ
+    std::vector<uint32_t> free_;     // δʹõĿ±
+    uint32_t head_ = kNone;
+    uint32_t tail_ = kNone;
+    size_t size_ = 0;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// н絥/߻ζУ˸дԼ±꣬Է±ֻ꣬ڿ/ʱȥԷĻ
+// ͨ front/pop ԭطʶͷٹ黹λʡȥһƶ
+template <typename T>
+class SPSCRingBuffer
+{
+public:
+    explicit SPSCRingBuffer(size_t capacity)
+        : head_(0), cached_tail_(0), tail_(0), cached_head_(0)
+    {
+        // ȡΪ 2 ݣȡģ
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        mask_ = size - 1;
+        slots_ = std::make_unique<T[]>(size);
+    }
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    // ߣʱ falseitem ֲ
+    bool try_push(T& item)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ > mask_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ > mask_)
+                return false;
+        }
+
+        slots_[head & mask_] = std::move(item);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ߣпʱ nullptrصָ pop ֮ǰЧ
+    T* front()
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_)
+                return nullptr;
+        }
+        return &slots_[tail & mask_];
+    }
+
+    // ߣֻ front طǿ֮
+    void pop()
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        slots_[tail & mask_] = T();  // ͷԪسеڴ棬Ȳλ
+        tail_.store(tail + 1, std::memory_order_release);
+    }
+
+    bool empty() const
+    {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    // ֵͳ
+    size_t size_approx() const
+    {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    size_t mask_;
+
+    // ߶ռĻ
+    alignas(64) std::atomic<size_t> head_;
+    size_t cached_tail_;
+
+    // ߶ռĻ
+    alignas(64) std::atomic<size_t> tail_;
+    size_t cached_head_;
+};
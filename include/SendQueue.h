@@ -0,0 +1,269 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "MPSCRingBuffer.h"
+
+enum class SendQueueKind {
+    Mutex = 0,   // std::deque + 
+    LockFree     // нζУʺ϶ͬʱ
+};
+
+// ʱĴʽ
+enum class OverflowPolicy {
+    Block = 0,   // ֱпλ I/O ߳ϵʱ˻Ϊ Fail
+    DropNewest,  // Ϣpush Է trueֻۼ dropped 
+    DropOldest,  // ͷɵϢΪϢڳλ
+    Fail         // ӣpush  falseۼ rejected 
+};
+
+struct SendQueueOptions {
+    SendQueueKind kind = SendQueueKind::Mutex;
+    // 0 ʾʹĬֵMutex ޳ȣLockFree Ϊ 65536LockFree ȡΪ 2 
+    size_t capacity = 0;
+    OverflowPolicy overflow = OverflowPolicy::DropNewest;
+};
+
+struct SendQueueStats {
+    size_t queued = 0;     // ǰŶֵ
+    uint64_t dropped = 0;  // DropNewest / DropOldest Ϣ
+    uint64_t rejected = 0; // Fail / Block ܾϢ
+    uint64_t replaced = 0; // ˺ϲģʽ±ͬһ topic Ϣ滻Ϣ
+};
+
+//  ThreadSafeZMQ* ķͶУ߳ pushI/O ߳ drain
+template <typename T>
+class SendQueue
+{
+public:
+    static constexpr size_t kDefaultLockFreeCapacity = 65536;
+
+    explicit SendQueue(const SendQueueOptions& options = SendQueueOptions())
+        : kind_(options.kind), capacity_(options.capacity), overflow_(options.overflow),
+          closed_(false), blocked_producers_(0), consumer_thread_(std::thread::id()), dropped_(0), rejected_(0)
+    {
+        if (kind_ == SendQueueKind::LockFree) {
+            ring_ = std::make_unique<MPSCRingBuffer<T>>(capacity_ > 0 ? capacity_ : kDefaultLockFreeCapacity);
+            capacity_ = ring_->capacity();
+        }
+    }
+
+    // ӣ false ʾϢܾFail Block ʱѹرգ
+    bool push(T item)
+    {
+        if (try_push(item))
+            return true;
+
+        switch (overflow_) {
+        case OverflowPolicy::DropNewest:
+            ++dropped_;
+            return true;
+
+        case OverflowPolicy::DropOldest:
+            return push_drop_oldest(item);
+
+        case OverflowPolicy::Block:
+            if (std::this_thread::get_id() != consumer_thread_.load(std::memory_order_relaxed))
+                return push_blocking(item);
+            break;
+
+        case OverflowPolicy::Fail:
+            break;
+        }
+
+        ++rejected_;
+        return false;
+    }
+
+    bool try_pop(T& out)
+    {
+        consumer_thread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        bool popped;
+        if (ring_) {
+            popped = ring_->try_pop(out);
+        }
+        else {
+            std::lock_guard<std::mutex> lock(mutex_);
+            popped = !queue_.empty();
+            if (popped) {
+                out = std::move(queue_.front());
+                queue_.pop_front();
+            }
+        }
+
+        if (popped)
+            wake_producers();
+        return popped;
+    }
+
+    // һȡ max_items ׷ӵ outȡ
+    size_t drain(std::deque<T>& out, size_t max_items = (std::numeric_limits<size_t>::max)())
+    {
+        consumer_thread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        size_t count = 0;
+        if (ring_) {
+            T item;
+            while (count < max_items && ring_->try_pop(item)) {
+                out.push_back(std::move(item));
+                ++count;
+            }
+        }
+        else {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (out.empty() && queue_.size() <= max_items) {
+                count = queue_.size();
+                std::swap(out, queue_);
+            }
+            else {
+                while (count < max_items && !queue_.empty()) {
+                    out.push_back(std::move(queue_.front()));
+                    queue_.pop_front();
+                    ++count;
+                }
+            }
+        }
+
+        if (count > 0)
+            wake_producers();
+        return count;
+    }
+
+    // ǰãѲܾе
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_t size() const
+    {
+        if (ring_)
+            return ring_->size_approx();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+    SendQueueStats stats() const
+    {
+        SendQueueStats result;
+        result.queued = size();
+        result.dropped = dropped_.load(std::memory_order_relaxed);
+        result.rejected = rejected_.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    SendQueueKind kind() const { return kind_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    // ԣʱ false  item ֲ
+    bool try_push(T& item)
+    {
+        if (ring_)
+            return ring_->try_push(item);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_ > 0 && queue_.size() >= capacity_)
+            return false;
+        queue_.push_back(std::move(item));
+        return true;
+    }
+
+    bool push_drop_oldest(T& item)
+    {
+        if (!ring_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (capacity_ > 0 && queue_.size() >= capacity_) {
+                queue_.pop_front();
+                ++dropped_;
+            }
+            queue_.push_back(std::move(item));
+            return true;
+        }
+
+        // ζ߳ӣ I/O ߳̾ʱඪһ
+        T oldest;
+        while (!ring_->try_push(item)) {
+            if (ring_->try_pop(oldest))
+                ++dropped_;
+        }
+        return true;
+    }
+
+    bool push_blocking(T& item)
+    {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (closed_)
+                    break;
+
+                if (!ring_) {
+                    not_full_.wait(lock, [this]() { return closed_ || queue_.size() < capacity_; });
+                    if (closed_)
+                        break;
+                    queue_.push_back(std::move(item));
+                    return true;
+                }
+
+                // е߲ mutex_óʱȴ׿©֪ͨ
+                ++blocked_producers_;
+                not_full_.wait_for(lock, std::chrono::milliseconds(1));
+                --blocked_producers_;
+            }
+
+            if (ring_->try_push(item))
+                return true;
+        }
+
+        ++rejected_;
+        return false;
+    }
+
+    void wake_producers()
+    {
+        if (overflow_ != OverflowPolicy::Block)
+            return;
+
+        if (ring_) {
+            if (blocked_producers_.load(std::memory_order_relaxed) == 0)
+                return;
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        not_full_.notify_all();
+    }
+
+    SendQueueKind kind_;
+    size_t capacity_;
+    OverflowPolicy overflow_;
+    std::unique_ptr<MPSCRingBuffer<T>> ring_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::deque<T> queue_;
+    bool closed_;
+    std::atomic<int> blocked_producers_;
+
+    // һγӵ̣߳Block ڸ߳ϲȴȴԼ
+    std::atomic<std::thread::id> consumer_thread_;
+
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> rejected_;
+};
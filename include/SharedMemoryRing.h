@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ByteView.h"
+
+struct SharedMemoryOptions {
+    size_t ring_bytes = 64 * 1024 * 1024;  // ȡΪ 2 ݣϢΪ 1/4
+    bool remove_on_close = false;          // ʱɾڴΣĬϱԱһʹ
+};
+
+// ӳ䵽ڴĵ/ֽڻ¼ȿɱ
+// Linux ʹ /dev/shmshm_openWindows ʹҳļֵ֧ӳ
+// ͬ˭ȴ˭ʼ֮Ĵ򿪷е
+// һ߳дʱɵ÷ֻһ
+class SharedMemoryRing
+{
+public:
+    // ӳʧʱ׳ std::runtime_error
+    SharedMemoryRing(const std::string& name, const SharedMemoryOptions& options = SharedMemoryOptions());
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    // ߣռ䲻ʱ false max_message_size ϢԶдȥ
+    bool try_write(const uint8_t* data, size_t size);
+
+    // ߣpeek ضͷ¼ͼֱָڴ棩 pop ͷ
+    bool peek(ByteView& out);
+    void pop();
+
+    bool empty() const;
+    // д뵫δѵļ¼ֵ
+    uint64_t queued() const;
+
+    // ׼ߣõȴٸ飬 true ʾߣߺ end_wait
+    bool begin_wait();
+    void end_wait();
+    // дãڵȴʱ trueֻһΣʱҪͻ֪ͨ
+    bool consumer_needs_wakeup();
+
+    size_t capacity() const { return capacity_; }
+    size_t max_message_size() const { return capacity_ / 4; }
+    const std::string& name() const { return name_; }
+
+    // ɾڴΣӳĽ̲Ӱ죻Windows һرʱԶɾ˺Ϊղ
+    static void remove(const std::string& name);
+
+private:
+    struct Header;
+
+    // ÿ¼ǰ 8 ֽͷΪ kWrapMarker ʾĿͷ
+    static constexpr uint32_t kWrapMarker = 0xFFFFFFFFu;
+    static constexpr size_t kRecordHeaderSize = 8;
+
+    static size_t record_size(size_t payload) { return kRecordHeaderSize + ((payload + 7) & ~static_cast<size_t>(7)); }
+    void map(size_t mapping_size);
+    void unmap();
+
+    std::string name_;
+    SharedMemoryOptions options_;
+    void* mapping_;
+    size_t mapping_size_;
+    intptr_t handle_;  // Linux ΪļWindows Ϊ HANDLE
+
+    Header* header_;
+    uint8_t* data_;
+    size_t capacity_;
+};
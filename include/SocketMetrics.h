@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct LatencySnapshot {
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t mean_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+};
+
+struct SocketMetricsSnapshot {
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t bytes_received = 0;
+    uint64_t send_failures = 0;     // socket ʧܣͶеĶ/ܾ
+    uint64_t dropped = 0;           // ͶаԶܾϢ
+    uint64_t retries = 0;
+    uint64_t timeouts = 0;
+    uint64_t lost = 0;              // Ķ˰ż⵽ȱûܲصϢ
+    uint64_t queue_depth = 0;       // ǰŶ
+    uint64_t queue_high_water = 0;  // I/O ߳ÿȡʱŶ
+    LatencySnapshot enqueue_to_wire;    // ӵ libzmq ܵʱ
+    LatencySnapshot callback_duration;  // ջصִʱ
+};
+
+// ۼͰںϲͬһͨ϶ socket ֱͼټλ
+struct HistogramCounts {
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+
+    LatencySnapshot summarize() const;
+};
+
+// HDR ӳֱͼ룩 2 ݷֶΣÿ 32 ͰԼ 3%
+// record ֻм relaxed ԭӲ I/O ̵߳·ϵ
+class LatencyHistogram
+{
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr size_t kSubBucketCount = size_t(1) << kSubBucketBits;
+    static constexpr int kMaxExponent = 44;  // Լ 4.9 СʱֵһͰ
+    static constexpr size_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+    LatencyHistogram();
+
+    void record(uint64_t value_ns);
+    void add_to(HistogramCounts& out) const;
+    LatencySnapshot snapshot() const;
+
+    static size_t BucketIndex(uint64_t value);
+    static uint64_t BucketUpperBound(size_t index);  // ͰڵֵΪλıֵ
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+// ÿ ThreadSafeZMQ* һݣ relaxed ԭ
+class SocketMetrics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // enqueued_at ΪĬֵʱֻ¼ӳ
+    void on_sent(size_t bytes, Clock::time_point enqueued_at = Clock::time_point())
+    {
+        messages_sent_.fetch_add(1, std::memory_order_relaxed);
+        bytes_sent_.fetch_add(bytes, std::memory_order_relaxed);
+        if (enqueued_at != Clock::time_point())
+            enqueue_to_wire_.record(ElapsedNanos(enqueued_at, Clock::now()));
+    }
+
+    void on_received(size_t bytes, Clock::time_point callback_start)
+    {
+        messages_received_.fetch_add(1, std::memory_order_relaxed);
+        bytes_received_.fetch_add(bytes, std::memory_order_relaxed);
+        callback_duration_.record(ElapsedNanos(callback_start, Clock::now()));
+    }
+
+    void on_send_failure() { send_failures_.fetch_add(1, std::memory_order_relaxed); }
+    void on_retry() { retries_.fetch_add(1, std::memory_order_relaxed); }
+    void on_timeout() { timeouts_.fetch_add(1, std::memory_order_relaxed); }
+    void on_lost(uint64_t count) { lost_.fetch_add(count, std::memory_order_relaxed); }
+
+    //  I/O ߳ȡʱ
+    void observe_queue_depth(size_t depth)
+    {
+        uint64_t current = queue_high_water_.load(std::memory_order_relaxed);
+        while (depth > current && !queue_high_water_.compare_exchange_weak(current, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    SocketMetricsSnapshot snapshot() const;
+
+private:
+    friend class SocketMetricsCollector;
+
+    static uint64_t ElapsedNanos(Clock::time_point from, Clock::time_point to)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+        return elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+    }
+
+    std::atomic<uint64_t> messages_sent_{ 0 };
+    std::atomic<uint64_t> bytes_sent_{ 0 };
+    std::atomic<uint64_t> messages_received_{ 0 };
+    std::atomic<uint64_t> bytes_received_{ 0 };
+    std::atomic<uint64_t> send_failures_{ 0 };
+    std::atomic<uint64_t> retries_{ 0 };
+    std::atomic<uint64_t> timeouts_{ 0 };
+    std::atomic<uint64_t> lost_{ 0 };
+    std::atomic<uint64_t> queue_high_water_{ 0 };
+    LatencyHistogram enqueue_to_wire_;
+    LatencyHistogram callback_duration_;
+};
+
+// ϲһͨ϶ socket ָ
+class SocketMetricsCollector
+{
+public:
+    void add(const SocketMetrics& metrics);
+    SocketMetricsSnapshot result() const;
+
+private:
+    SocketMetricsSnapshot totals_;
+    HistogramCounts enqueue_to_wire_;
+    HistogramCounts callback_duration_;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <cstdint>
+#include <optional>
+
+// ͨ ZMQ socket Ŀɵѡδõ libzmq װԼĬֵ
+//  ThreadSafeZMQ* ڴ socket bind/connect ֮ǰӦãHWMaffinity ֮òЧ
+struct SocketOptions {
+    std::optional<int> sndhwm;           // ÿԶ˵ŶϢޣ0 = ޣlibzmq Ĭ 1000
+    std::optional<int> rcvhwm;
+    std::optional<int> sndbuf;           // ں socket ֽ-1 = ϵͳĬ
+    std::optional<int> rcvbuf;
+    std::optional<int> linger;           // رʱȴδϢĺ0 = -1 = һֱȴ
+    std::optional<int> sndtimeo;         // շĳʱ-1 = ʱ
+    std::optional<int> rcvtimeo;
+    std::optional<int> tcp_keepalive;    // -1 = ϵͳĬϣ0 = رգ1 = 
+    std::optional<int> tcp_keepalive_idle;   // 룬-1 = ϵͳĬ
+    std::optional<int> tcp_keepalive_intvl;
+    std::optional<int> tcp_keepalive_cnt;
+    std::optional<uint64_t> affinity;    //  socket  I/O ߳λ룬 set_io_threads  socket
+    std::optional<bool> immediate;       // ֻѽӵĶԶŶӣڼ䲻ٶѻϢ
+
+    void apply(zmq::socket_t& socket) const {
+        if (sndhwm)
+            socket.set(zmq::sockopt::sndhwm, *sndhwm);
+        if (rcvhwm)
+            socket.set(zmq::sockopt::rcvhwm, *rcvhwm);
+        if (sndbuf)
+            socket.set(zmq::sockopt::sndbuf, *sndbuf);
+        if (rcvbuf)
+            socket.set(zmq::sockopt::rcvbuf, *rcvbuf);
+        if (linger)
+            socket.set(zmq::sockopt::linger, *linger);
+        if (sndtimeo)
+            socket.set(zmq::sockopt::sndtimeo, *sndtimeo);
+        if (rcvtimeo)
+            socket.set(zmq::sockopt::rcvtimeo, *rcvtimeo);
+        if (tcp_keepalive)
+            socket.set(zmq::sockopt::tcp_keepalive, *tcp_keepalive);
+        if (tcp_keepalive_idle)
+            socket.set(zmq::sockopt::tcp_keepalive_idle, *tcp_keepalive_idle);
+        if (tcp_keepalive_intvl)
+            socket.set(zmq::sockopt::tcp_keepalive_intvl, *tcp_keepalive_intvl);
+        if (tcp_keepalive_cnt)
+            socket.set(zmq::sockopt::tcp_keepalive_cnt, *tcp_keepalive_cnt);
+        if (affinity)
+            socket.set(zmq::sockopt::affinity, *affinity);
+        if (immediate)
+            socket.set(zmq::sockopt::immediate, *immediate);
+    }
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "SharedMemoryRing.h"
+#include "ZMQReactor.h"
+#include "ByteView.h"
+#include "SocketMetrics.h"
+
+// ڴ PushPull Ľնˣʱ ipc ֪ͨϣʱȡ ZMQ
+// ͼصֱָڴ棬صغöοռŹ黹Ͷ
+class ThreadSafeShmPuller {
+public:
+    using MessageCallback = std::function<void(const std::vector<uint8_t>&)>;
+    using ViewCallback = std::function<void(ByteView data)>;                 // ͼֻڻصڼЧ
+    using OwnedMessageCallback = std::function<void(zmq::message_t&& msg)>;  // ڴ󽻸ص
+
+    ThreadSafeShmPuller(zmq::context_t& context, const std::string& name, ZMQReactor* reactor = nullptr,
+        const SharedMemoryOptions& shm_options = SharedMemoryOptions());
+    ~ThreadSafeShmPuller();
+
+    // ֻص⣬õЧ
+    void set_callback(MessageCallback callback);
+    void set_view_callback(ViewCallback callback);
+    void set_message_callback(OwnedMessageCallback callback);
+    // ÿ־¼ȡһϢ ZMQReactor::kMaxReceiveBatch ڽ߳ϵã set_message_callback 
+    void set_batch_end_callback(std::function<void()> callback);
+
+    const SocketMetrics& metrics() const { return metrics_; }
+
+private:
+    void puller_loop();             // ߳ģʽ
+    void on_reactor_doorbell();     // reactor ģʽ
+    void drain_doorbell();
+    size_t receive_batch(size_t max_records);  // شļ¼
+    void deliver(ByteView data);
+
+    std::unique_ptr<SharedMemoryRing> ring_;
+    std::unique_ptr<zmq::socket_t> doorbell_;
+    std::thread receiver_thread_;
+    std::atomic<bool> running_;
+
+    MessageCallback message_callback_;
+    ViewCallback view_callback_;
+    OwnedMessageCallback owned_callback_;
+    std::function<void()> batch_end_callback_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+    int timer_id_;
+    // reactor ͶݵִУж϶Ƿ
+    std::shared_ptr<std::atomic<bool>> alive_;
+
+    std::string name_;
+    SocketMetrics metrics_;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "SharedMemoryRing.h"
+#include "SendQueue.h"
+#include "SocketMetrics.h"
+
+// ڴ PushPull ķͶˣϢֱӿڴ滷 I/O ̺߳ںЭջ
+// ZMQ ֻڽնʱ 1 ֽڵĻ֪ͨipc߸¼֪ͨ
+class ThreadSafeShmPusher {
+public:
+    ThreadSafeShmPusher(zmq::context_t& context, const std::string& name, const SendQueueOptions& queue_options = SendQueueOptions(),
+        const SharedMemoryOptions& shm_options = SharedMemoryOptions());
+    ~ThreadSafeShmPusher();
+
+    // ̰߳ȫʱ queue_options.overflow DropOldest ޷ն˵ݣ DropNewest 
+    //  SharedMemoryRing::max_message_size ϢֱӾܾ
+    bool send_async(const uint8_t* data, size_t size);
+    bool send_async(const std::vector<uint8_t>& data);
+    bool send_async(zmq::message_t&& msg);
+
+    SendQueueStats queue_stats() const;
+    const SocketMetrics& metrics() const { return metrics_; }
+
+private:
+    bool wait_for_space(const uint8_t* data, size_t size);
+
+    std::unique_ptr<SharedMemoryRing> ring_;
+    std::unique_ptr<zmq::socket_t> doorbell_;
+    std::mutex write_mutex_;  // ֵֻ֧д뷽doorbell_ Ҳ̰߳ȫ
+
+    OverflowPolicy overflow_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> rejected_;
+
+    std::string name_;
+    SocketMetrics metrics_;
+};
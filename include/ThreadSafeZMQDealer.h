@@ -7,24 +7,90 @@
 #include <condition_variable>
 #include <atomic>
 #include <functional>
+#include <future>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ZMQSignaler.h"
+#include "SendQueue.h"
+#include "ZMQMessageUtils.h"
+#include "ByteView.h"
+#include "TimerWheel.h"
+#include "SocketMetrics.h"
+
+struct DealerReply {
+    RequestStatus status = RequestStatus::Ok;
+    std::vector<uint8_t> data;
+};
+
 class ThreadSafeZMQDealer {
 public:
     using MessageCallback = std::function<void(const std::vector<uint8_t>&)>;
+    using ViewCallback = std::function<void(ByteView data)>;                 // ͼֻڻصڼЧ
+    using OwnedMessageCallback = std::function<void(zmq::message_t&& msg)>;  // ϢȨص
+    // ɻص I/O ִ߳Уrequest_id  request_async ķֵdata ֻڻصڼЧ Ok ʱΪ
+    using ReplyCallback = std::function<void(uint64_t request_id, RequestStatus status, ByteView data)>;
 
-    ThreadSafeZMQDealer(zmq::context_t& context, const std::string& address);
+    static constexpr std::chrono::milliseconds kDefaultRequestTimeout{ 2000 };
+
+    ThreadSafeZMQDealer(zmq::context_t& context, const std::string& address, ZMQReactor* reactor = nullptr,
+        const SendQueueOptions& queue_options = SendQueueOptions(), const SocketOptions& socket_options = SocketOptions());
     ~ThreadSafeZMQDealer();
 
-    void send_async(const std::vector<uint8_t>& data);
+    //  false ʾͶаԾܾ˸Ϣ
+    bool send_async(const std::vector<uint8_t>& data);
+    // 㿽ͣȨֱӽ libzmq
+    bool send_async(std::vector<uint8_t>&& data);
+    bool send_async(zmq::message_t&& msg);
+
+    //  id 첽󣺷 [֡][]Router ͬһ id ظ cb
+    // ͬʱд;԰ timeout ʱع id0 ʾͶоܾʱص
+    uint64_t request_async(zmq::message_t&& msg, ReplyCallback cb,
+        std::chrono::milliseconds timeout = kDefaultRequestTimeout);
+    uint64_t request_async(const std::vector<uint8_t>& data, ReplyCallback cb,
+        std::chrono::milliseconds timeout = kDefaultRequestTimeout);
+    std::future<DealerReply> request_async(const std::vector<uint8_t>& data,
+        std::chrono::milliseconds timeout = kDefaultRequestTimeout);
+
+    size_t pending_requests() const;
+
+    SendQueueStats queue_stats() const { return send_queue_.stats(); }
+    // ֻص⣬õЧ
     void set_callback(MessageCallback cb);
+    void set_view_callback(ViewCallback cb);
+    void set_message_callback(OwnedMessageCallback cb);
+    // ÿ־¼ȡһϢ ZMQReactor::kMaxReceiveBatch ڽ߳ϵã set_message_callback 
+    void set_batch_end_callback(std::function<void()> callback);
     void set_timeout_callback(std::function<void()> callback);
 
+    const SocketMetrics& metrics() const { return metrics_; }
+
 private:
+    // correlation_id Ϊ 0 ʾͨϢ
+    struct OutgoingMessage {
+        uint64_t correlation_id = 0;
+        zmq::message_t content;
+        SocketMetrics::Clock::time_point enqueued_at;
+    };
+
     std::function<void()> timeout_callback_;
 
     void dealer_loop();
+    bool receive_message();  // ûпɶϢʱ false
+    void receive_available();
+    void send_queued(zmq::send_flags flags);
+    // reactor ģʽdontwait ֱ EAGAINδ pending_ ȴһ POLLOUT
+    void send_pending();
+    bool send_one(OutgoingMessage& msg, zmq::send_flags flags);
+    void on_reactor_writable();
+    bool enqueue(OutgoingMessage&& msg);
+    // ȡɾ id ӦĻصɣظʱʱؿ
+    ReplyCallback take_request(uint64_t correlation_id);
+    void expire_requests();
+    void disarm_request_timer();  // ÷ requests_mutex_
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
@@ -32,9 +98,27 @@ private:
     std::atomic<bool> running_;
     std::thread dealer_thread_;
 
-    std::mutex send_mutex_;
-    std::queue<std::vector<uint8_t>> send_queue_;
-    std::condition_variable cv_;
+    SendQueue<OutgoingMessage> send_queue_;
+    std::unique_ptr<ZMQSignaler> signaler_;  // ߳ģʽ» dealer_loop
+    std::deque<OutgoingMessage> pending_;     // ȡδϢ reactor ̷߳
 
     MessageCallback message_callback_;
+    ViewCallback view_callback_;
+    OwnedMessageCallback owned_callback_;
+    std::function<void()> batch_end_callback_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+    int timer_id_;
+    std::atomic<bool> flush_scheduled_;
+    bool received_since_tick_;  //  reactor ̷߳
+
+    // ;󣺹 id -> صʱʱֹȡĶʱ
+    mutable std::mutex requests_mutex_;
+    std::unordered_map<uint64_t, ReplyCallback> requests_;
+    TimerWheel request_timers_;
+    std::atomic<uint64_t> next_correlation_id_;
+    int request_timer_id_;  // reactor ģʽֻʱַǿʱעᣬδעʱΪ -1 requests_mutex_ 
+
+    SocketMetrics metrics_;
 };
@@ -8,19 +8,52 @@
 #include <functional>
 #include <atomic>
 
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ZMQSignaler.h"
+#include "SendQueue.h"
+#include "ZMQMessageUtils.h"
+#include "ByteView.h"
+#include "SocketMetrics.h"
+
 class ThreadSafeZMQPair {
 public:
     using MessageCallback = std::function<void(const std::vector<uint8_t>&)>;
+    using ViewCallback = std::function<void(ByteView data)>;                 // ͼֻڻصڼЧ
+    using OwnedMessageCallback = std::function<void(zmq::message_t&& msg)>;  // ϢȨص
 
-    ThreadSafeZMQPair(zmq::context_t& context, const std::string& address, bool isBind);
+    // reactor Ϊʱעᵽ reactor ̣߳Դ io ߳
+    ThreadSafeZMQPair(zmq::context_t& context, const std::string& address, bool isBind, ZMQReactor* reactor = nullptr,
+        const SendQueueOptions& queue_options = SendQueueOptions(), const SocketOptions& socket_options = SocketOptions());
     ~ThreadSafeZMQPair();
 
-    void send_async(const std::vector<uint8_t>& data);
+    //  false ʾͶаԾܾ˸Ϣ
+    bool send_async(const std::vector<uint8_t>& data);
+    // 㿽ͣȨֱӽ libzmq
+    bool send_async(std::vector<uint8_t>&& data);
+    bool send_async(zmq::message_t&& msg);
+
+    SendQueueStats queue_stats() const { return send_queue_.stats(); }
+    const SocketMetrics& metrics() const { return metrics_; }
 
+    // ֻص⣬õЧ
     void set_callback(MessageCallback callback);
+    void set_view_callback(ViewCallback callback);
+    void set_message_callback(OwnedMessageCallback callback);
+    // ÿ־¼ȡһϢ ZMQReactor::kMaxReceiveBatch ڽ߳ϵã set_message_callback 
+    void set_batch_end_callback(std::function<void()> callback);
 
 private:
+    struct OutgoingMessage {
+        zmq::message_t content;
+        SocketMetrics::Clock::time_point enqueued_at;
+    };
+
     void io_loop();
+    bool receive_one();  // ûпɶϢʱ false
+    void receive_available();
+    void send_queued(int max_batch);
+    void on_reactor_events(short revents);
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
@@ -28,11 +61,19 @@ private:
     bool isBind_;
     std::atomic<bool> running_;
 
-    std::queue<std::vector<uint8_t>> send_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable cv_;
+    SendQueue<OutgoingMessage> send_queue_;
+    std::unique_ptr<ZMQSignaler> signaler_;  // ߳ģʽ» io_loop
 
     std::thread io_thread_;
 
+    ZMQReactor* reactor_;
+    int reactor_id_;
+    std::atomic<bool> flush_scheduled_;
+
     MessageCallback message_callback_;
+    ViewCallback view_callback_;
+    OwnedMessageCallback owned_callback_;
+    std::function<void()> batch_end_callback_;
+
+    SocketMetrics metrics_;
 };
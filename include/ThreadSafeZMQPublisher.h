@@ -10,16 +10,59 @@
 #include <vector>
 #include <variant>
 
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ZMQSignaler.h"
+#include "SendQueue.h"
+#include "ConflatingQueue.h"
+#include "LastValueCache.h"
+#include "RetransmitBuffer.h"
+#include "ZMQMessageUtils.h"
+#include "SocketMetrics.h"
+
+struct PublisherOptions {
+    // ϲģʽͬһ topic δľϢϢ滻߿ʱֻÿ topic ֵ
+    // úʹ SendQueueOptions ĶУгȲ topic 
+    bool conflate = false;
+    // ÿ topic һηϢ弰 topic ţͨ last_value ѯ
+    bool last_value_cache = false;
+    // ǿʱڸõַ ROUTER ṩշĶĶ˾ݴȡø topic ĵǰֵ last_value_cache
+    // ʱÿϢ󸽼һ֡ [topic][body][]Ķ˰ŰѿʵʱϢνݴ˷ֶ
+    std::string snapshot_address;
+    // > 0 ʱÿ topic ôѷϢĶ˷ȱʱͨ snapshot_address 󲹷Ҫ snapshot_address
+    size_t retransmit_depth = 0;
+};
+
 class ThreadSafeZMQPublisher
 {
 public:
-    ThreadSafeZMQPublisher(zmq::context_t& context, const std::string& address, bool isBind = true);
+    ThreadSafeZMQPublisher(zmq::context_t& context, const std::string& address, bool isBind = true, ZMQReactor* reactor = nullptr,
+        const SendQueueOptions& queue_options = SendQueueOptions(), const SocketOptions& socket_options = SocketOptions(),
+        const PublisherOptions& publisher_options = PublisherOptions());
     ~ThreadSafeZMQPublisher();
 
-    void publish_async(const std::string& topic, const std::vector<uint8_t>& data);
+    //  false ʾͶаԾܾ˸Ϣ
+    bool publish_async(const std::string& topic, const std::vector<uint8_t>& data);
+    // 㿽ϢȨֱӽ libzmq
+    bool publish_async(const std::string& topic, std::vector<uint8_t>&& data);
+    bool publish_async(const std::string& topic, zmq::message_t&& msg);
+
+    // ϲģʽ replaced Ϊ滻ľϢ
+    SendQueueStats queue_stats() const;
+    const SocketMetrics& metrics() const { return metrics_; }
+
+    // topic һηϢ壨ѷϢݣδûûи topic ʱ false
+    bool last_value(const std::string& topic, zmq::message_t& out) const;
 
 private:
     void publisher_loop();
+    void serve_requests();  // ظ벹 I/O ִ߳
+    void serve_snapshot(zmq::message_t& identity, const zmq::message_t& prefix);
+    void serve_retransmit(zmq::message_t& identity, const std::vector<zmq::message_t>& frames);
+    size_t drain_queue();  // ӷͶлϲȡϢ pending_
+    bool queue_empty() const;
+    void send_pending();  // ֱ EAGAIN߳ģʽ reactor ģʽ
+    void on_reactor_writable();
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
@@ -29,12 +72,24 @@ private:
 
     struct OutgoingMessage {
         std::string topic;
-        std::vector<uint8_t> content;
+        zmq::message_t content;
+        SocketMetrics::Clock::time_point enqueued_at;
     };
 
-    std::queue<OutgoingMessage> send_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable cv_;
+    SendQueue<OutgoingMessage> send_queue_;
+    std::unique_ptr<ConflatingQueue<OutgoingMessage>> conflating_queue_;  // ϲģʽ´ send_queue_
+    std::unique_ptr<LastValueCache> last_values_;                         // δʱΪ
+    std::unique_ptr<zmq::socket_t> snapshot_socket_;                      // δÿշʱΪ
+    std::unique_ptr<RetransmitBuffer> retransmit_;                        // δòʱΪգֻ I/O ߳Ϸ
+    std::deque<OutgoingMessage> pending_;    // ȡδϢ I/O ̷߳
+    std::unique_ptr<ZMQSignaler> signaler_;  // ߳ģʽ» publisher_loop
     std::thread publisher_thread_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+    int snapshot_reactor_id_;
+    std::atomic<bool> flush_scheduled_;
+
+    SocketMetrics metrics_;
 };
 
@@ -6,25 +6,50 @@
 #include <atomic>
 #include <functional>
 
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ByteView.h"
+#include "SocketMetrics.h"
+
 class ThreadSafeZMQPuller {
 public:
     using MessageCallback = std::function<void(const std::vector<uint8_t>&)>;
+    using ViewCallback = std::function<void(ByteView data)>;                 // ͼֻڻصڼЧ
+    using OwnedMessageCallback = std::function<void(zmq::message_t&& msg)>;  // ϢȨص
 
-    ThreadSafeZMQPuller(zmq::context_t& context, const std::string& address, bool isBind);
+    ThreadSafeZMQPuller(zmq::context_t& context, const std::string& address, bool isBind, ZMQReactor* reactor = nullptr,
+        const SocketOptions& socket_options = SocketOptions());
     ~ThreadSafeZMQPuller();
 
     // ýյϢʱĻص
+    // ֻص⣬õЧͼ message_t 汾ʡȥÿϢһηͿ
     void set_callback(MessageCallback callback);
+    void set_view_callback(ViewCallback callback);
+    void set_message_callback(OwnedMessageCallback callback);
+    // ÿ־¼ȡһϢ ZMQReactor::kMaxReceiveBatch ڽ߳ϵã set_message_callback 
+    void set_batch_end_callback(std::function<void()> callback);
+
+    const SocketMetrics& metrics() const { return metrics_; }
 
 private:
     void puller_loop(); // ̨̺߳
+    bool receive_one();  // ûпɶϢʱ false
+    void receive_available();
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
     std::thread receiver_thread_;
     std::atomic<bool> running_;
     MessageCallback message_callback_;
+    ViewCallback view_callback_;
+    OwnedMessageCallback owned_callback_;
+    std::function<void()> batch_end_callback_;
 
     std::string address_;
     bool isBind_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+
+    SocketMetrics metrics_;
 };
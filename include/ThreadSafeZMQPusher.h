@@ -10,26 +10,54 @@
 #include <vector>
 #include <variant>
 
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ZMQSignaler.h"
+#include "SendQueue.h"
+#include "ZMQMessageUtils.h"
+#include "SocketMetrics.h"
+
 class ThreadSafeZMQPusher {
 public:
-    ThreadSafeZMQPusher(zmq::context_t& context, const std::string& address, bool isBind);
+    ThreadSafeZMQPusher(zmq::context_t& context, const std::string& address, bool isBind, ZMQReactor* reactor = nullptr,
+        const SendQueueOptions& queue_options = SendQueueOptions(), const SocketOptions& socket_options = SocketOptions());
     ~ThreadSafeZMQPusher();
 
     // 첽Ϣ̰߳ȫ
-    void send_async(const std::vector<uint8_t>& data);
+    //  false ʾͶаԾܾ˸Ϣ
+    bool send_async(const std::vector<uint8_t>& data);
+    // 㿽ͣȨֱӽ libzmq
+    bool send_async(std::vector<uint8_t>&& data);
+    bool send_async(zmq::message_t&& msg);
+
+    SendQueueStats queue_stats() const { return message_queue_.stats(); }
+    const SocketMetrics& metrics() const { return metrics_; }
 
 private:
+    struct OutgoingMessage {
+        zmq::message_t content;
+        SocketMetrics::Clock::time_point enqueued_at;
+    };
+
     void pusher_loop(); // ̨̺߳
+    void send_pending();  // ֱ EAGAIN߳ģʽ reactor ģʽ
+    void on_reactor_writable();
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
 
-    std::queue<std::vector<uint8_t>> message_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable cv_;
+    SendQueue<OutgoingMessage> message_queue_;
+    std::deque<OutgoingMessage> pending_;  // ȡδϢ I/O ̷߳
+    std::unique_ptr<ZMQSignaler> signaler_;     // ߳ģʽ» pusher_loop
     std::atomic<bool> running_;
     std::thread sender_thread_;
     
     std::string address_;
     bool isBind_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+    std::atomic<bool> flush_scheduled_;
+
+    SocketMetrics metrics_;
 };
@@ -13,29 +13,56 @@
 #include <msgpack.hpp>
 
 #include "MessagePackData.h"
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ZMQSignaler.h"
+#include "SendQueue.h"
+#include "ByteView.h"
+#include "SocketMetrics.h"
 
 class ThreadSafeZMQReplier
 {
 public:
     using MessageCallback = std::function<void(const std::vector<uint8_t>&)>;
+    using ViewCallback = std::function<void(ByteView data)>;                 // ͼֻڻصڼЧ
+    using OwnedMessageCallback = std::function<void(zmq::message_t&& msg)>;  // ϢȨص
 
-    ThreadSafeZMQReplier(zmq::context_t& context, const std::string& address);
+    ThreadSafeZMQReplier(zmq::context_t& context, const std::string& address, ZMQReactor* reactor = nullptr,
+        const SocketOptions& socket_options = SocketOptions());
     ~ThreadSafeZMQReplier();
 
+    // ֻص⣬õЧ
     void set_callback(MessageCallback cb);
+    void set_view_callback(ViewCallback cb);
+    void set_message_callback(OwnedMessageCallback cb);
 
+    // ̵߳ãreactor ģʽͶݵ reactor ̣߳߳ģʽӺ replier_loop 
     void send_reply(const std::vector<uint8_t>& reply);
 
+    const SocketMetrics& metrics() const { return metrics_; }
+
 private:
     void replier_loop();
+    void receive_one();
+    void send_now(const std::vector<uint8_t>& reply);
+    void send_queued();
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
     std::string address_;
     std::atomic<bool> running_;
     std::thread replier_thread_;
-    std::mutex send_mutex_;
+
+    SendQueue<std::vector<uint8_t>> send_queue_;
+    std::unique_ptr<ZMQSignaler> signaler_;  // ߳ģʽ» replier_loop
 
     MessageCallback message_callback_;
+    ViewCallback view_callback_;
+    OwnedMessageCallback owned_callback_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+
+    SocketMetrics metrics_;
 };
 
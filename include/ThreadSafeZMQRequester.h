@@ -10,41 +10,129 @@
 #include <vector>
 #include <variant>
 #include <functional>
+#include <map>
+#include <unordered_map>
+#include <chrono>
 #include <msgpack.hpp>
 
 #include "MessagePackData.h"
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ZMQSignaler.h"
+#include "SendQueue.h"
+#include "ZMQMessageUtils.h"
+#include "SocketMetrics.h"
+
+struct RequesterOptions {
+    // falseREQ socketһֻһ;ʱط
+    // trueDEALER socket֡Ϊ [request id][֡][]ͬʱ; id ƥӦ
+    //       Զԭؿ֮֡ǰŷ⣺REP socketлȫŷ֡ ROUTER
+    //        ThreadSafeZMQRouter ֻһ֡ΪԶˣ ThreadSafeZMQDealer::request_async
+    bool pipelined = false;
+    size_t max_in_flight = 1024;                               // ˮģʽͬʱ;
+    std::chrono::milliseconds request_timeout{ 3000 };         // ˮģʽÿĬϳʱ
+};
 
 class ThreadSafeZMQRequester
 {
 public:
     using MessageCallback = std::function<void(const std::vector<uint8_t>&)>;
+    // ÿǡûصһΣstatus Ϊ Ok ʱ reply Ϊ
+    using StatusCallback = std::function<void(RequestStatus status, const std::vector<uint8_t>& reply)>;
 
-    ThreadSafeZMQRequester(zmq::context_t& context, const std::string& address);
+    ThreadSafeZMQRequester(zmq::context_t& context, const std::string& address, ZMQReactor* reactor = nullptr,
+        const SendQueueOptions& queue_options = SendQueueOptions(), const RequesterOptions& options = RequesterOptions(),
+        const SocketOptions& socket_options = SocketOptions());
     ~ThreadSafeZMQRequester();
 
-    // 첽Ӧͨص
-    void send_request_async(const std::vector<uint8_t>& data, MessageCallback cb);
+    // 첽Ӧͨصأʱʱȡ cbֻ set_timeout_callback õĻص
+    //  false ʾаԾܾ˸cb ᱻ
+    // timeout ֻˮģʽЧ0 ʾʹ RequesterOptions::request_timeout
+    bool send_request_async(const std::vector<uint8_t>& data, MessageCallback cb,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    // 㿽ͣȨֱӽ libzmqʱֻü
+    bool send_request_async(std::vector<uint8_t>&& data, MessageCallback cb,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    bool send_request_async(zmq::message_t&& msg, MessageCallback cb,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    // ͬϣӦʱʱȡͨԼĻص
+    bool send_request_async(const std::vector<uint8_t>& data, StatusCallback cb,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    bool send_request_async(std::vector<uint8_t>&& data, StatusCallback cb,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+    bool send_request_async(zmq::message_t&& msg, StatusCallback cb,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0));
+
+    SendQueueStats queue_stats() const { return request_queue_.stats(); }
 
+    // һʱãֻ MessageCallback ʱȡҲãĸʧܼ StatusCallback  status
     void set_timeout_callback(std::function<void()> callback);
 
+    const SocketMetrics& metrics() const { return metrics_; }
+
 private:
     std::function<void()> timeout_callback_;
 
+    // ֻӦĻصʱɸ timeout_callback_ȡʱһ
+    StatusCallback adapt_callback(MessageCallback cb);
+
     void requester_loop();
 
+    // ״̬߳ģʽ reactor ģʽãֻ I/O ߳ϵ
+    void start_next_request();
+    void transmit_current();
+    void receive_reply();
+    void check_reply_timeout();
+    void finish_current(RequestStatus status, const std::vector<uint8_t>& reply);
+
+    // ˮģʽֻ I/O ߳ϵ
+    void pipelined_loop();
+    void pipeline_send();
+    void pipeline_receive();
+    void pipeline_expire();
+    std::chrono::milliseconds pipeline_wait_time() const;
+
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
     bool running_;
     std::string address_;
 
     struct OutgoingRequest {
-        std::vector<uint8_t> content;
-        MessageCallback callback;
+        zmq::message_t content;
+        StatusCallback callback;
+        std::chrono::milliseconds timeout{ 0 };
+        SocketMetrics::Clock::time_point enqueued_at;
     };
 
-    std::queue<OutgoingRequest> request_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable cv_;
+    using Deadlines = std::multimap<std::chrono::steady_clock::time_point, uint64_t>;
+
+    struct PendingRequest {
+        StatusCallback callback;
+        Deadlines::iterator deadline;
+    };
+
+    SendQueue<OutgoingRequest> request_queue_;
+    std::unique_ptr<ZMQSignaler> signaler_;  // ߳ģʽ» requester_loop
     std::thread requester_thread_;
+
+    OutgoingRequest current_;
+    bool in_flight_;
+    int retry_count_;
+    std::chrono::steady_clock::time_point reply_deadline_;
+
+    // ˮģʽĹrequest id -> صdeadlines_ ʱ
+    RequesterOptions options_;
+    std::unordered_map<uint64_t, PendingRequest> pending_requests_;
+    Deadlines deadlines_;
+    uint64_t next_request_id_;
+    OutgoingRequest unsent_;  //  EAGAIN δܷ
+    bool has_unsent_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+    int timer_id_;
+
+    SocketMetrics metrics_;
 };
 
@@ -9,26 +9,98 @@
 #include <queue>
 #include <vector>
 
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ZMQSignaler.h"
+#include "SendQueue.h"
+#include "ByteView.h"
+#include "SocketMetrics.h"
+#include "RouterIdentityTable.h"
+
+struct RouterOptions {
+    // Զ identity ʱ̭ûϢĶԶˣľ֮ʧЧ
+    size_t identity_capacity = 16384;
+};
+
 class ThreadSafeZMQRouter {
 public:
     using MessageCallback = std::function<void(const std::vector<uint8_t>& id, const std::vector<uint8_t>& data)>;
+    // id  data ֻڻصڼЧ
+    using ViewCallback = std::function<void(ByteView id, ByteView data)>;
+    // ϢȨصid ͼҪظʱб
+    using OwnedMessageCallback = std::function<void(ByteView id, zmq::message_t&& data)>;
+    // Dealer::request_async 󣬻ظʱ send_to(identity, correlation_id, data) ع id
+    using RequestCallback = std::function<void(ByteView id, uint64_t correlation_id, ByteView data)>;
+    // ԶԽվظʱ send_to(peer, ...)ر identity
+    using PeerHandle = RouterIdentityTable::Handle;
+    using HandleCallback = std::function<void(PeerHandle peer, zmq::message_t&& data)>;
 
-    ThreadSafeZMQRouter(zmq::context_t& context, const std::string& address);
+    ThreadSafeZMQRouter(zmq::context_t& context, const std::string& address, ZMQReactor* reactor = nullptr,
+        const SocketOptions& socket_options = SocketOptions(), const RouterOptions& router_options = RouterOptions());
     ~ThreadSafeZMQRouter();
 
+    // ֻص⣬õЧ
     void set_callback(MessageCallback cb);
+    void set_view_callback(ViewCallback cb);
+    void set_message_callback(OwnedMessageCallback cb);
+    void set_handle_callback(HandleCallback cb);
+    // ÿ־¼ȡһϢ ZMQReactor::kMaxReceiveBatch ڽ߳ϵã set_message_callback 
+    void set_batch_end_callback(std::function<void()> callback);
+    // ֻ֡δʱͨϢĻص
+    void set_request_callback(RequestCallback cb);
 
+    // ̵߳ãreactor ģʽͶݵ reactor ̣߳߳ģʽӺ router_loop 
     void send_to(const std::vector<uint8_t>& identity, const std::vector<uint8_t>& data);
+    void send_to(const std::vector<uint8_t>& identity, uint64_t correlation_id, const std::vector<uint8_t>& data);
+    // ѱ̭ʱϢ send_failures
+    void send_to(PeerHandle peer, const std::vector<uint8_t>& data);
+    void send_to(PeerHandle peer, uint64_t correlation_id, const std::vector<uint8_t>& data);
+
+    // identity 飻δ֪Զ˷ RouterIdentityTable::kInvalidHandleʧЧ false
+    PeerHandle handle_of(ByteView identity) const { return identities_.find(identity); }
+    bool identity_of(PeerHandle peer, std::vector<uint8_t>& identity) const { return identities_.resolve(peer, identity); }
+
+    const SocketMetrics& metrics() const { return metrics_; }
 
 private:
+    // ߳ģʽŶӵĻظpeer Ϊ kInvalidHandle ʱ identity 
+    struct OutgoingReply {
+        PeerHandle peer = RouterIdentityTable::kInvalidHandle;
+        std::vector<uint8_t> identity;
+        uint64_t correlation_id = 0;
+        std::vector<uint8_t> data;
+    };
+
     void router_loop();
+    bool receive_one();  // ûпɶϢʱ false
+    void receive_available();
+    void enqueue(OutgoingReply&& reply);
+    void send_queued();
+    // correlation_id Ϊ 0 ʱ [id][֡][data] [id][֡][data]
+    void send_now(const std::vector<uint8_t>& identity, uint64_t correlation_id, const std::vector<uint8_t>& data);
+    void send_now(PeerHandle peer, uint64_t correlation_id, const std::vector<uint8_t>& data);
+    bool send_frames(zmq::message_t& id_msg, uint64_t correlation_id, const std::vector<uint8_t>& data);
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
     std::string address_;
     std::atomic<bool> running_;
     std::thread router_thread_;
-    std::mutex send_mutex_;
+
+    SendQueue<OutgoingReply> send_queue_;
+    std::unique_ptr<ZMQSignaler> signaler_;  // ߳ģʽ» router_loop
 
     MessageCallback message_callback_;
+    ViewCallback view_callback_;
+    OwnedMessageCallback owned_callback_;
+    HandleCallback handle_callback_;
+    std::function<void()> batch_end_callback_;
+    RequestCallback request_callback_;
+
+    RouterIdentityTable identities_;  // ̵߳Ǽǣ߳̽
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+
+    SocketMetrics metrics_;
 };
@@ -10,19 +10,113 @@
 #include <vector>
 #include <variant>
 #include <functional>
+#include <map>
+#include <memory>
+#include <string_view>
+
+#include "ZMQReactor.h"
+#include "SocketOptions.h"
+#include "ByteView.h"
+#include "SocketMetrics.h"
+#include "ZMQSignaler.h"
+#include "TopicTrie.h"
+
+//  topic עĻصƥ䣺Prefix  libzmq ĶĹһ£Exact ֻ topic ȫͬϢ
+enum class TopicMatch {
+    Prefix,
+    Exact
+};
+
+struct SubscriberOptions {
+    // ǿʱӷ˵ĿշPublisherOptions::snapshot_addressÿ¶ȡƥ topic ĵǰֵ
+    // ʵʱϢ topic νӣŲѽֵϢصῴֵظֵ
+    // ԾϢ metrics  lostŴͷʼĶҪ´
+    std::string snapshot_address;
+    // ȱʱͨ snapshot_address 󲹷 retransmit_depth
+    // 򳬹 recovery_timeout ֮ǰ topic 󵽵Ϣݴ棬ص԰˳յļ lost
+    bool recover_gaps = false;
+    std::chrono::milliseconds recovery_timeout{ 200 };
+};
 
 class ThreadSafeZMQSubscriber
 {
 public:
     using MessageCallback = std::function<void(const std::string& topic, const std::vector<uint8_t>& data)>;
+    // topic  data ֻڻصڼЧ
+    using ViewCallback = std::function<void(std::string_view topic, ByteView data)>;
+    // ϢȨص
+    using OwnedMessageCallback = std::function<void(std::string_view topic, zmq::message_t&& data)>;
+    //  topic עĻصһϢͬʱжǰ׺صֻͼ
+    using TopicCallback = std::function<void(std::string_view topic, ByteView data)>;
 
-    ThreadSafeZMQSubscriber(zmq::context_t& context, const std::string& address, const std::string& topicFilter, bool isBind = false);
+    ThreadSafeZMQSubscriber(zmq::context_t& context, const std::string& address, const std::string& topicFilter, bool isBind = false, ZMQReactor* reactor = nullptr,
+        const SocketOptions& socket_options = SocketOptions(), const SubscriberOptions& subscriber_options = SubscriberOptions());
     ~ThreadSafeZMQSubscriber();
 
+    // ֻص⣬õЧ
+    // Ĭϻصֻ޻صģʱ topicFilter  subscribe(topic)ûб topic ĻصϢ
     void set_callback(MessageCallback cb);
+    void set_view_callback(ViewCallback cb);
+    void set_message_callback(OwnedMessageCallback cb);
+    // ÿ־¼ȡһϢ ZMQReactor::kMaxReceiveBatch ڽ߳ϵã set_message_callback 
+    void set_batch_end_callback(std::function<void()> callback);
+
+    // ʱģ̵߳ãڽ߳첽Ч
+    // subscribe(topic) һĬϻصĶģصİ汾еϢ callbackͬһ topic ͬһƥ䷽ʽٴעʱ滻
+    // ƥ䰴 topic ǰ׺ַֻ topic йأжʱȰǰ׺ɶ̵ȫƥ
+    // unsubscribe Ƴ topic ϵȫص
+    void subscribe(const std::string& topic);
+    void subscribe(const std::string& topic, TopicCallback callback, TopicMatch match = TopicMatch::Prefix);
+    void unsubscribe(const std::string& topic);
+
+    const SocketMetrics& metrics() const { return metrics_; }
 
 private:
+    // ͬһ topic ϵĶģֻڽ߳Ϸ
+    struct Subscription {
+        bool default_callback = false;
+        TopicCallback prefix_callback;
+        TopicCallback exact_callback;
+    };
+
+    struct SubscriptionChange {
+        enum class Kind { AddDefault, AddPrefix, AddExact, Remove } kind;
+        std::string topic;
+        TopicCallback callback;
+    };
+
+    void post_change(SubscriptionChange change);
+    void apply_changes();  // ڽִ߳
+    void rebuild_topic_trie();
+    void dispatch(std::string_view topic, zmq::message_t&& body);
+    void dispatch_default(std::string_view topic, zmq::message_t&& body);
+    void deliver(std::string_view topic, zmq::message_t&& body);
+
+    // ÿ topic ״ֻ̬ڽ߳Ϸ
+    struct TopicSequence {
+        uint64_t delivered = 0;      // ѽţ0 ʾûл׼
+        uint64_t recovering_to = 0;  // ڲȱյ㣬0 ʾûڲ
+        SocketMetrics::Clock::time_point deadline;
+        std::map<uint64_t, zmq::message_t> held;  // ڼ䵽ĺϢ
+    };
+    // ͸Ƚ string_view ң·Ѽ topic ٹ std::string
+    using TopicSequences = std::map<std::string, TopicSequence, std::less<>>;
+
+    void request_snapshot(const std::string& prefix);
+    void receive_replies();  // տ벹ظڽִ߳
+    int receive_snapshot(const zmq::message_t& tag);
+    int receive_retransmit(const zmq::message_t& tag);
+    // ·ؽصϢ
+    int on_sequenced(std::string_view topic, uint64_t sequence, zmq::message_t&& body);
+    TopicSequences::iterator sequence_of(std::string_view topic);  // һμ topic ½״̬
+    void start_recovery(const std::string& topic, TopicSequence& state, uint64_t from, uint64_t to);
+    int finish_recovery(const std::string& topic, TopicSequence& state);
+    int expire_recoveries();
+    void forget_sequences(const std::string& prefix);
+
     void subscriber_loop();
+    bool receive_one();  // ûпɶϢʱ false
+    void receive_available();
 
     zmq::context_t& context_;
     std::unique_ptr<zmq::socket_t> socket_;
@@ -32,6 +126,33 @@ private:
     bool isBind_;
 
     MessageCallback message_callback_;
+    ViewCallback view_callback_;
+    OwnedMessageCallback owned_callback_;
+    std::function<void()> batch_end_callback_;
     std::thread subscriber_thread_;
+
+    std::map<std::string, Subscription> subscriptions_;  // std::map ڵַȶtopic_handlers_ ֱָ
+    std::vector<Subscription*> topic_handlers_;          // topic_trie_ еֵ±
+    TopicTrie topic_trie_;
+    bool has_topic_callbacks_;  // ûа topic Ļصʱǰ׺ֱӽĬϻص
+
+    std::unique_ptr<zmq::socket_t> snapshot_socket_;                 // δÿʱΪ
+    TopicSequences topic_sequences_;
+    size_t recovering_topics_;
+    bool recover_gaps_;
+    std::chrono::milliseconds recovery_timeout_;
+    int recovery_timer_id_;
+
+    std::mutex changes_mutex_;
+    std::vector<SubscriptionChange> pending_changes_;
+
+    ZMQReactor* reactor_;
+    int reactor_id_;
+    int snapshot_reactor_id_;
+    std::unique_ptr<ZMQSignaler> signaler_;  // ߳ģʽ» poll Ӧöı仯
+    // reactor ͶݵĶı仯ִУж϶Ƿ
+    std::shared_ptr<std::atomic<bool>> alive_;
+
+    SocketMetrics metrics_;
 };
 
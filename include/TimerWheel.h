@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// ϣʱ֣ O(1)ÿ tick ֻһλʺϴͬʱ;ĳʱ
+// ֧ʽȡʱɵ÷ key ǷȻЧkey ã
+// ̰߳ȫʹ÷
+class TimerWheel
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TimerWheel(std::chrono::milliseconds tick, size_t slot_count)
+        : tick_(tick.count() > 0 ? tick : std::chrono::milliseconds(1)),
+          slots_(slot_count > 0 ? slot_count : 1), cursor_(0), size_(0), last_tick_(Clock::now())
+    {
+    }
+
+    void schedule(uint64_t key, std::chrono::milliseconds delay)
+    {
+        // ֿܾܺûƽڿʼʱĿ׷ϵ tick ǰ
+        if (size_ == 0)
+            last_tick_ = Clock::now();
+
+        // ȡ tickٵȴһ tick
+        size_t ticks = static_cast<size_t>((delay.count() + tick_.count() - 1) / tick_.count());
+        if (ticks == 0)
+            ticks = 1;
+
+        size_t slot = (cursor_ + ticks - 1) % slots_.size();
+        slots_[slot].push_back({ key, (ticks - 1) / slots_.size() });
+        ++size_;
+    }
+
+    // ƽ nowѵڵ key ׷ӵ expired
+    void advance(Clock::time_point now, std::vector<uint64_t>& expired)
+    {
+        while (now - last_tick_ >= tick_) {
+            last_tick_ += tick_;
+
+            std::vector<Entry>& slot = slots_[cursor_];
+            size_t kept = 0;
+            for (size_t i = 0; i < slot.size(); ++i) {
+                if (slot[i].rounds == 0) {
+                    expired.push_back(slot[i].key);
+                    --size_;
+                }
+                else {
+                    --slot[i].rounds;
+                    slot[kept++] = slot[i];
+                }
+            }
+            slot.resize(kept);
+            cursor_ = (cursor_ + 1) % slots_.size();
+
+            // ʱûƽʱ̱߳𣩣ֲ tick ׷
+            if (size_ == 0) {
+                last_tick_ = now;
+                break;
+            }
+        }
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+    std::chrono::milliseconds tick() const { return tick_; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        size_t rounds;  // תȦ
+    };
+
+    std::chrono::milliseconds tick_;
+    std::vector<std::vector<Entry>> slots_;
+    size_t cursor_;
+    size_t size_;
+    Clock::time_point last_tick_;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//  topic ֽƥֻǰ׺ҿֻ topic йأĿ޹
+// нڵһͬһڵӽڵҰֽĿ仯ʱؽ
+// ÿڵɴֵexact ֻ topic ýڵȫͬʱУprefix ڸýڵ topic ǰ׺ʱ
+// ̰߳ȫʹ÷֤ͬһ߳
+class TopicTrie
+{
+public:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Entry {
+        std::string key;
+        uint32_t exact = kNone;
+        uint32_t prefix = kNone;
+    };
+
+    //  entries 滻ȫݣkey ͬĿֻһ
+    void build(std::vector<Entry> entries);
+
+    //  topic ·λص visit(value, is_exact)Ǹǰ׺ֵɶ̵ȫƥֵ
+    template <typename Visitor>
+    void match(std::string_view topic, Visitor&& visit) const
+    {
+        if (nodes_.empty())
+            return;
+
+        const Node* node = &nodes_[0];
+        for (size_t depth = 0;; ++depth) {
+            if (node->prefix != kNone)
+                visit(node->prefix, false);
+            if (depth == topic.size()) {
+                if (node->exact != kNone)
+                    visit(node->exact, true);
+                return;
+            }
+
+            const Node* first = nodes_.data() + node->first_child;
+            const Node* last = first + node->child_count;
+            uint8_t byte = static_cast<uint8_t>(topic[depth]);
+            const Node* child = std::lower_bound(first, last, byte,
+                [](const Node& n, uint8_t b) { return n.byte < b; });
+            if (child == last || child->byte != byte)
+                return;
+            node = child;
+        }
+    }
+
+    bool empty() const { return nodes_.empty(); }
+    size_t node_count() const { return nodes_.size(); }
+
+private:
+    struct Node {
+        uint32_t first_child = 0;
+        uint32_t exact = kNone;
+        uint32_t prefix = kNone;
+        uint16_t child_count = 0;
+        uint8_t byte = 0;
+    };
+
+    // entries[begin, end)  key ԳΪ depth ͬǰ׺ͷnode ǰ׺
+    void build_node(uint32_t node, size_t depth, const std::vector<Entry>& entries, size_t begin, size_t end);
+
+    std::vector<Node> nodes_;
+};
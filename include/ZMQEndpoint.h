@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+
+enum class ZMQTransport {
+    Unknown = 0,
+    Tcp,
+    Ipc,     // Unix domain socketWindows 10 1803 ֮ libzmq 4.3 Ҳ֧
+    Inproc,  // ͬһ̡ͬһ context ڵ̼߳ͨţκںЭջ
+    SharedMemory  // ̼ͬĹڴ滷 PushPull ֧֣ ThreadSafeShmPusher
+};
+
+// õַĹʶ𣬱дǰ׺
+// ֮ͬ߳ inprocͬĽ֮ ipcֻпҪ tcp
+struct ZMQEndpoint {
+    // ͨͬһ contextinproc ڽΨһ
+    static std::string inproc(const std::string& name) {
+        return "inproc://" + name;
+    }
+
+    // Linux ·ŵ /tmpWindows ڵǰĿ¼· sockaddr_un ƣԼ 100 ֽڣ
+    static std::string ipc(const std::string& name) {
+#ifdef _WIN32
+        return "ipc://" + name + ".ipc";
+#else
+        return "ipc:///tmp/" + name + ".ipc";
+#endif
+    }
+
+    // ͬʱڴͻ֪ͨ ipc ַֻĸֺ '-'
+    static std::string shm(const std::string& name) {
+        return "shm://" + name;
+    }
+
+    static std::string tcp_bind(int port) {
+        return "tcp://*:" + std::to_string(port);
+    }
+
+    static std::string tcp_loopback(int port) {
+        return "tcp://127.0.0.1:" + std::to_string(port);
+    }
+
+    static ZMQTransport transport(const std::string& address) {
+        if (address.compare(0, 9, "inproc://") == 0)
+            return ZMQTransport::Inproc;
+        if (address.compare(0, 6, "ipc://") == 0)
+            return ZMQTransport::Ipc;
+        if (address.compare(0, 6, "tcp://") == 0)
+            return ZMQTransport::Tcp;
+        if (address.compare(0, 6, "shm://") == 0)
+            return ZMQTransport::SharedMemory;
+        return ZMQTransport::Unknown;
+    }
+
+    // ȥ scheme ǰ׺ "shm://camera0" -> "camera0"
+    static std::string path(const std::string& address) {
+        size_t pos = address.find("://");
+        return pos == std::string::npos ? address : address.substr(pos + 3);
+    }
+
+    // inproc ռ context  I/O ֻ̣߳ inproc Ľ̿԰ io_threads Ϊ 0
+    static bool uses_io_thread(const std::string& address) {
+        return transport(address) != ZMQTransport::Inproc;
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <zmq.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+// 첽״̬Dealer::request_async ˮ Requester 
+enum class RequestStatus {
+    Ok = 0,
+    Timeout,     // ʱǰûյӦĻظ
+    SendFailed,  // socket ʧ
+    Cancelled    // ʱδ
+};
+
+class ZMQMessageUtils {
+public:
+    // һε zmq::message_t÷ԭݵȨ
+    static zmq::message_t FromBytes(const std::vector<uint8_t>& data) {
+        return zmq::message_t(data.data(), data.size());
+    }
+
+    // 㿽 vector Ļ libzmqzmq_msg_init_dataϢͷʱɾ vector
+    static zmq::message_t FromBytes(std::vector<uint8_t>&& data) {
+        if (data.empty())
+            return zmq::message_t();
+
+        auto* owner = new std::vector<uint8_t>(std::move(data));
+        return zmq::message_t(owner->data(), owner->size(), &ZMQMessageUtils::ReleaseBytes, owner);
+    }
+
+    // /Ӧ֡1 ֽڱ + 8 ֽڹ idDealer  Router ֮ʹ
+    static constexpr uint8_t kCorrelationTag = 0xC7;
+    static constexpr size_t kCorrelationFrameSize = 1 + sizeof(uint64_t);
+
+    static zmq::message_t MakeCorrelationFrame(uint64_t correlation_id) {
+        zmq::message_t frame(kCorrelationFrameSize);
+        uint8_t* out = static_cast<uint8_t*>(frame.data());
+        out[0] = kCorrelationTag;
+        std::memcpy(out + 1, &correlation_id, sizeof(correlation_id));
+        return frame;
+    }
+
+    static bool ParseCorrelationFrame(const zmq::message_t& frame, uint64_t& correlation_id) {
+        if (frame.size() != kCorrelationFrameSize || static_cast<const uint8_t*>(frame.data())[0] != kCorrelationTag)
+            return false;
+        std::memcpy(&correlation_id, static_cast<const uint8_t*>(frame.data()) + 1, sizeof(correlation_id));
+        return correlation_id != 0;
+    }
+
+    // ֡1 ֽڱ + 8 ֽ topic ţ 1 ʼ׷ [topic][body] ֮
+    static constexpr uint8_t kSequenceTag = 0x5E;
+    static constexpr size_t kSequenceFrameSize = 1 + sizeof(uint64_t);
+
+    static zmq::message_t MakeSequenceFrame(uint64_t sequence) {
+        zmq::message_t frame(kSequenceFrameSize);
+        uint8_t* out = static_cast<uint8_t*>(frame.data());
+        out[0] = kSequenceTag;
+        std::memcpy(out + 1, &sequence, sizeof(sequence));
+        return frame;
+    }
+
+    static bool ParseSequenceFrame(const zmq::message_t& frame, uint64_t& sequence) {
+        if (frame.size() != kSequenceFrameSize || static_cast<const uint8_t*>(frame.data())[0] != kSequenceTag)
+            return false;
+        std::memcpy(&sequence, static_cast<const uint8_t*>(frame.data()) + 1, sizeof(sequence));
+        return sequence != 0;
+    }
+
+    // · ROUTER ظ֡1 ֽڣֿ벹
+    //  [kSnapshotTag][topic ǰ׺]ظ [kSnapshotTag] ֮ÿ topic Ϊ [topic][֡][body]
+    //  [kRetransmitTag][topic][ʼ֡][֡]ظ [kRetransmitTag][topic][֡] ֮ [֡][body]
+    static constexpr uint8_t kSnapshotTag = 0x5A;
+    static constexpr uint8_t kRetransmitTag = 0x52;
+
+private:
+    // libzmq һͷʱã libzmq  I/O ߳
+    static void ReleaseBytes(void* /*data*/, void* hint) {
+        delete static_cast<std::vector<uint8_t>*>(hint);
+    }
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <cstddef>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ZMQSignaler.h"
+
+//  socket һ I/O ̣߳ͳһ zmq::poll  pollitemٰ revents ַԵĴ
+class ZMQReactor
+{
+public:
+    using SocketHandler = std::function<void(short revents)>;
+    using Task = std::function<void()>;
+
+    // նһξ¼ȡϢͬһ߳ϵķͺ socket
+    static constexpr size_t kMaxReceiveBatch = 256;
+
+    // cpu_index >= 0 ʱ reactor ̰߳󶨵ָ CPU
+    explicit ZMQReactor(zmq::context_t& context, int cpu_index = -1);
+    ~ZMQReactor();
+
+    // ע/ע socket̰߳ȫremove_socket غٱ
+    int add_socket(zmq::socket_t& socket, short events, SocketHandler handler);
+    void set_events(int id, short events);
+    void remove_socket(int id);
+
+    // ڶʱ reactor ִ߳
+    int add_timer(std::chrono::milliseconds interval, Task task);
+    void remove_timer(int id);
+
+    // Ͷ reactor ִ߳Уsocket ֻ reactor ߳϶д
+    void post(Task task);
+    bool in_reactor_thread() const;
+
+private:
+    struct SocketEntry {
+        int id;
+        void* handle;
+        short events;
+        SocketHandler handler;
+        bool removed;
+    };
+
+    struct TimerEntry {
+        int id;
+        std::chrono::milliseconds interval;
+        std::chrono::steady_clock::time_point next_due;
+        Task task;
+        bool removed;
+    };
+
+    void reactor_loop();
+    void run_pending_tasks();
+    std::chrono::milliseconds run_due_timers();
+    void rebuild_poll_items();
+    void call_sync(Task task);  //  reactor ִ߳вȴ
+
+    // post ʱ zmq::poll е reactor ߳
+    ZMQSignaler signaler_;
+
+    // ³Աֻ reactor ߳Ϸʣitems_[0] ̶ signaler_
+    std::vector<SocketEntry> sockets_;
+    std::vector<TimerEntry> timers_;
+    std::vector<zmq::pollitem_t> items_;
+    bool items_dirty_;
+
+    std::mutex task_mutex_;
+    std::vector<Task> pending_tasks_;
+
+    std::atomic<bool> running_;
+    std::atomic<int> next_id_;
+    int cpu_index_;
+    std::thread reactor_thread_;
+    // reactor_loop ʼʱд룻reactor_thread_ ߳űֵin_reactor_thread ܶ
+    std::atomic<std::thread::id> reactor_thread_id_;
+};
+
+// N  reactor ̣߳ע socket 
+class ZMQReactorPool
+{
+public:
+    ZMQReactorPool(zmq::context_t& context, size_t thread_count, bool pin_threads);
+
+    ZMQReactor& next();
+    size_t size() const { return reactors_.size(); }
+
+private:
+    std::vector<std::unique_ptr<ZMQReactor>> reactors_;
+    std::atomic<size_t> next_index_;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <zmq.hpp>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+//  inproc PAIR ĻͨѶ˼ pollitem̵߳ notify  zmq::poll 
+class ZMQSignaler
+{
+public:
+    explicit ZMQSignaler(zmq::context_t& context);
+    ~ZMQSignaler();
+
+    // ̵߳ã notify ڱǰֻһź
+    void notify();
+
+    // ɵȴ POLLIN ãȡźţ֮ټԼĶ
+    void consume();
+
+    zmq::pollitem_t pollitem();
+
+private:
+    std::unique_ptr<zmq::socket_t> reader_;
+    std::unique_ptr<zmq::socket_t> writer_;
+    std::mutex writer_mutex_;  // zmq socket ̰߳ȫ
+    std::atomic<bool> pending_;
+    std::string endpoint_;
+};
@@ -14,6 +14,15 @@
 #include "ThreadSafeZMQPuller.h"
 #include "ThreadSafeZMQDealer.h"
 #include "ThreadSafeZMQRouter.h"
+#include "ThreadSafeShmPusher.h"
+#include "ThreadSafeShmPuller.h"
+#include "ZMQReactor.h"
+#include "CallbackExecutor.h"
+#include "SendQueue.h"
+#include "ZMQMessageUtils.h"
+#include "ZMQEndpoint.h"
+#include "ByteView.h"
+#include "ReceiveQueue.h"
 
 enum class ZMQMode {
     Pair = 0,
@@ -23,38 +32,135 @@ enum class ZMQMode {
     DealerRouter
 };
 
+// ͨã socket ѡ
+struct ChannelOptions {
+    SendQueueOptions send_queue;
+    RequesterOptions requester;  //  ReqRep ʹ
+    DispatchOptions dispatch;    // ջصڹִ̳߳УĬ I/O ֱִ߳
+    SharedMemoryOptions shm;     //  PushPull ʹ shm:// ַʱЧ
+    SocketOptions socket;        // Ӧõͨϵÿ ZMQ socket
+    PublisherOptions publisher;  //  PubSub ķʹ
+    SubscriberOptions subscriber;  //  PubSub ĶĶʹ
+    RouterOptions router;          //  DealerRouter  Router ʹ
+};
+
+// صеһϢͼֻڻصڼЧ
+struct ReceivedMessage {
+    ByteView key;   // PubSub Ϊ topicRouter ΪԶ identityģʽΪ
+    ByteView data;
+};
+
 class ZMQSocketManager {
 public:
     // 캯ʼͺͽյַ
-    ZMQSocketManager(ZMQMode mode, const std::string& sendAddress = "", const std::string& recvAddress = "", const std::string& topicFilter = "");
+    ZMQSocketManager(ZMQMode mode, const std::string& sendAddress = "", const std::string& recvAddress = "", const std::string& topicFilter = "",
+        const ChannelOptions& options = ChannelOptions());
 
     // ԶԴ
     ~ZMQSocketManager();
 
-    // 첽Ϣ
-    void send_async(const std::vector<uint8_t>& data);
-    void send_sub_async(const std::vector<uint8_t>& data, const std::string& topic = "");
+    // 첽Ϣֵ汾ѻȨֱӽ libzmqٿ
+    //  false ʾûпɷ͵ socketͶаԾܾ˸Ϣ
+    bool send_async(const std::vector<uint8_t>& data);
+    bool send_async(std::vector<uint8_t>&& data);
+    bool send_async(zmq::message_t&& msg);
+    bool send_sub_async(const std::vector<uint8_t>& data, const std::string& topic = "");
+    bool send_sub_async(std::vector<uint8_t>&& data, const std::string& topic = "");
+    bool send_sub_async(zmq::message_t&& msg, const std::string& topic = "");
+
+    //  topic ֵ ChannelOptions::publisher.last_value_cache
+    bool get_last_value(const std::string& topic, zmq::message_t& out) const;
+
+    // ͶеŶ붪/ܾûзͶʱȫ 0
+    SendQueueStats get_send_queue_stats() const;
+
+    // ͨ socket շӳٷֲϼƣqueue_depth ȡԷͶУdropped նкͻص̳߳ضϢ
+    SocketMetricsSnapshot get_metrics() const;
 
     // ýջص
     void set_callback(std::function<void(const std::vector<uint8_t>&)> callback);
     void set_sub_callback(std::function<void(const std::string& topic, const std::vector<uint8_t>& data)> callback);
     void set_router_callback(std::function<void(const std::vector<uint8_t>& id, const std::vector<uint8_t>& data)> callback);
 
+    // 㿽գͼֻڻصڼЧmessage 汾 zmq::message_t Ȩص
+    //  vector 汾⣬õЧ
+    //  ChannelOptions::dispatch ϻصڹִ߳УϢתƣ⿽
+    void set_view_callback(std::function<void(ByteView data)> callback);
+    void set_sub_view_callback(std::function<void(std::string_view topic, ByteView data)> callback);
+    void set_router_view_callback(std::function<void(ByteView id, ByteView data)> callback);
+    void set_message_callback(std::function<void(zmq::message_t&& msg)> callback);
+    void set_sub_message_callback(std::function<void(std::string_view topic, zmq::message_t&& data)> callback);
+    void set_router_message_callback(std::function<void(ByteView id, zmq::message_t&& data)> callback);
+    // Զ identity еľ send_router_reply(peer, ...) ظ router ص
+    void set_router_handle_callback(ThreadSafeZMQRouter::HandleCallback callback);
+
+    // գһ poll ȡϢÿ ZMQReactor::kMaxReceiveBatch һνصʺϿԱ߽ȵεÿĳ
+    // ص⣬õЧ dispatch ʱΪһڹִ߳
+    // ReqRep Ϊһһ𣬲֧ص
+    using BatchCallback = std::function<void(const ReceivedMessage* messages, size_t count)>;
+    void set_batch_callback(BatchCallback callback);
+
+    // ȡģʽյϢŽΪ capacity ĽնУɵ÷Լ߳ȡߣĻص
+    // ص⣬֮ûصʱвյϢظ÷ͬһСReqRep ֧֣ nullptr
+    // ʱϢ get_metrics().dropped
+    ReceiveQueue* enable_receive_queue(size_t capacity = 65536);
+    ReceiveQueue* receive_queue() const { return receive_queue_.get(); }  // δʱΪ nullptr
+
     void send_replier_reply(const std::vector<uint8_t>& data);
     void send_router_reply(const std::vector<uint8_t>& id, const std::vector<uint8_t>& data);
 
+    // Dealer/Router -ӦDealer ˿ͬʱ󣬸Գʱ
+    // ص汾ع id0 ʾû Dealer Ͷоܾfuture 汾 SendFailed
+    uint64_t request_async(const std::vector<uint8_t>& data, ThreadSafeZMQDealer::ReplyCallback callback,
+        std::chrono::milliseconds timeout = ThreadSafeZMQDealer::kDefaultRequestTimeout);
+    std::future<DealerReply> request_async(const std::vector<uint8_t>& data,
+        std::chrono::milliseconds timeout = ThreadSafeZMQDealer::kDefaultRequestTimeout);
+    // Router յ id  send_router_reply(id, correlation_id, data) ظ
+    void set_router_request_callback(ThreadSafeZMQRouter::RequestCallback callback);
+    void send_router_reply(const std::vector<uint8_t>& id, uint64_t correlation_id, const std::vector<uint8_t>& data);
+    void send_router_reply(ThreadSafeZMQRouter::PeerHandle peer, const std::vector<uint8_t>& data);
+    void send_router_reply(ThreadSafeZMQRouter::PeerHandle peer, uint64_t correlation_id, const std::vector<uint8_t>& data);
+
+    // PubSub ĶʱģصĶİ topic ǰ׺ַĻص
+    //  dispatch ʱ topic Ļصڹִ߳УϢᱻһ
+    void subscribe(const std::string& topic);
+    void subscribe(const std::string& topic, ThreadSafeZMQSubscriber::TopicCallback callback, TopicMatch match = TopicMatch::Prefix);
+    void unsubscribe(const std::string& topic);
+
     // óʱص Dealer 첽ͣ
     void set_timeout_callback(std::function<void()> callback);
 
     // رͨ
     void shutdown();
 
+    //  reactor ģʽ֮󴴽ͨٸ̣߳עᵽ reactor ߳
+    static void enable_reactor_mode(size_t reactor_threads = 1, bool pin_threads = false);
+
+    // ù context  I/O ߳Ĭ 1ڴκͨ reactor ģʽ֮ǰã򷵻 false
+    //  tcp/ipc ɰÿ GB/s һ̹߳㣻ֻ inproc Ľ̿Ϊ 0
+    static bool set_io_threads(int io_threads);
+
 private:
     static zmq::context_t& get_shared_context() {
         static zmq::context_t context(1); // ̰߳ȫľֲ̬
         return context;
     }
 
+    // ǹ context ѱʹã˺޸ io_threads
+    static zmq::context_t& use_shared_context();
+
+    // δ reactor ģʽʱ nullptr
+    static ZMQReactor* acquire_reactor();
+
+    // ѽջصװΪͶݵ executor_ δ̳߳ʱԭ
+    std::function<void(zmq::message_t&&)> dispatched(std::function<void(zmq::message_t&&)> callback);
+    std::function<void(std::string_view, zmq::message_t&&)> dispatched_sub(std::function<void(std::string_view, zmq::message_t&&)> callback);
+    std::function<void(ByteView, zmq::message_t&&)> dispatched_router(std::function<void(ByteView, zmq::message_t&&)> callback);
+
+    // Ȩ汾Ļصõǰģʽնˣkey Ϊ topic / identity÷ callback_mutex_
+    // ǰģʽûֵ֧նʱ false
+    bool set_keyed_receiver(std::function<void(std::string_view key, zmq::message_t&& msg)> callback, std::function<void()> batch_end);
+
     std::function<void(const std::vector<uint8_t>&)> response_callback_;
 
     std::function<void()> timeout_callback_;
@@ -70,10 +176,17 @@ private:
     std::unique_ptr<ThreadSafeZMQPusher> pusher_;
     std::unique_ptr<ThreadSafeZMQPuller> puller_;
 
+    // PushPull ʹ shm:// ַʱ pusher_/puller_
+    std::unique_ptr<ThreadSafeShmPusher> shm_pusher_;
+    std::unique_ptr<ThreadSafeShmPuller> shm_puller_;
+
     std::unique_ptr<ThreadSafeZMQDealer> dealer_;
     std::unique_ptr<ThreadSafeZMQRouter> router_;
 
     std::mutex callback_mutex_;  // صõĻ
 
+    std::unique_ptr<CallbackExecutor> executor_;  // δ dispatch ʱΪ
+    std::unique_ptr<ReceiveQueue> receive_queue_;  // δȡģʽʱΪ
+
     ZMQMode mode_;
 };
@@ -8,18 +8,193 @@
 #endif
 
 extern "C" {
+	// ͨã C# ˵ StructLayout.Sequential ṹһһӦ
+	// ֶֻ׷ĩβ÷ struct_size ΪԼṹĴС InitChannelOptions
+	// ֻȡ struct_size ǵֶΣɵĵ÷ȱٵβֶȡĬֵ
+	typedef struct ZMQChannelOptions {
+		uint32_t struct_size;     // sizeof(ZMQChannelOptions)Ϊ 0 ʱṹ屻
+		int send_queue_kind;      // 0 = У1 = ζ
+		int send_queue_capacity;  // Ͷ<= 0 ʹĬֵв޳ȣ
+		int send_queue_overflow;  // ʱ0 = ĬϣϢ1 = 2 = Ϣ3 = Ϣ4 = ʧ
+		int requester_pipelined;  //  0 ʱʹ DEALER ˮģʽ
+		int requester_max_in_flight;  // <= 0 ʹĬֵ
+		int request_timeout_ms;       // <= 0 ʹĬֵ
+		int dispatch_threads;         // > 0 ʱصڸĹִ߳У I/O ֱ߳ӻص
+		int dispatch_ordering;        // 0 = ֤˳1 = ͬһ Router identity 2 = ͬһ topic 
+		int shm_ring_mb;              // PushPull ʹ shm:// ַʱڴ滷ĴСMB<= 0 ʹĬֵ
+		int publisher_conflate;       //  0 ʱ˰ topic ϲδϢֵֻ
+		int publisher_last_value_cache;  //  0 ʱ˱ÿ topic ֵ GetLastValue
+		const char* publisher_snapshot_address;   // ǿʱڸõַṩշ publisher_last_value_cache
+		const char* subscriber_snapshot_address;  // ǿʱĶ˴Ӹõַȡ topic ĵǰֵٽʵʱϢ
+		int publisher_retransmit_depth;     // > 0 ʱΪÿ topic ôϢҪ publisher_snapshot_address
+		int subscriber_recover_gaps;        //  0 ʱĶ˷ȱں󲹷Ҫ subscriber_snapshot_address
+		int subscriber_recovery_timeout_ms; // ȴʱ䣬<= 0 ʹĬֵ
+		int router_identity_capacity;       // Router Զ˾<= 0 ʹĬֵʱ̭ûϢĶԶ
+	} ZMQChannelOptions;
+
+	// ZMQ socket ѡ InitSocketOptions ֶΪ ZMQ_SOCKOPT_UNSET޸Ҫֶ
+	// δõֶα libzmq ĬֵȡֵΧͬ zmq_setsockopt
+	enum {
+		ZMQ_SOCKOPT_UNSET = -2147483647 - 1
+	};
+
+	typedef struct ZMQSocketOptions {
+		int sndhwm;
+		int rcvhwm;
+		int sndbuf;
+		int rcvbuf;
+		int linger_ms;
+		int sndtimeo_ms;
+		int rcvtimeo_ms;
+		int tcp_keepalive;
+		int tcp_keepalive_idle;
+		int tcp_keepalive_intvl;
+		int tcp_keepalive_cnt;
+		int immediate;
+		uint64_t affinity;  // 0 ʾ
+	} ZMQSocketOptions;
+
+	// ѯṹ ZMQChannelOptions һֻĩβ׷ֶΣ÷ struct_size ΪԼṹĴС
+	// ֻд struct_size ǵֶΣstruct_size Ϊ 0 ʱ ZMQ_RESULT_INVALID_ARGUMENT
+	typedef struct ZMQSendQueueStats {
+		uint32_t struct_size;  // sizeof(ZMQSendQueueStats)
+		int64_t queued;
+		int64_t dropped;
+		int64_t rejected;
+		int64_t replaced;  // ˺ϲģʽ±Ϣ滻Ϣ
+	} ZMQSendQueueStats;
+
+	typedef struct ZMQLatencyStats {
+		int64_t count;
+		int64_t min_ns;
+		int64_t max_ns;
+		int64_t mean_ns;
+		int64_t p50_ns;
+		int64_t p90_ns;
+		int64_t p99_ns;
+		int64_t p999_ns;
+	} ZMQLatencyStats;
+
+	typedef struct ZMQChannelMetrics {
+		uint32_t struct_size;  // sizeof(ZMQChannelMetrics)
+		int64_t messages_sent;
+		int64_t bytes_sent;
+		int64_t messages_received;
+		int64_t bytes_received;
+		int64_t send_failures;
+		int64_t dropped;
+		int64_t retries;
+		int64_t timeouts;
+		int64_t queue_depth;
+		int64_t queue_high_water;
+		ZMQLatencyStats enqueue_to_wire;    // ӵ libzmq 
+		ZMQLatencyStats callback_duration;  // ջصִʱ
+		int64_t lost;                       // Ķ˼⵽ȱûܲصϢ
+	} ZMQChannelMetrics;
+
+	// Send / SendWithTopic ķֵ
+	enum {
+		ZMQ_SEND_OK = 0,
+		ZMQ_SEND_INVALID_ARGUMENT = -1,
+		ZMQ_SEND_REJECTED = -2    // ͶΪʧܣͨûзͶ
+	};
+
+	// շĵãEnablePullModeGet* ѯȣͨ÷ֵȡЧʱҲ ZMQ_RESULT_INVALID_ARGUMENT
+	enum {
+		ZMQ_RESULT_OK = 0,
+		ZMQ_RESULT_INVALID_ARGUMENT = -1,
+		ZMQ_RESULT_NOT_SUPPORTED = -5   // ǰͨģʽָ֧ò
+	};
+
+	// TryReceive / ReceiveMany ķֵɹʱֱ𷵻 1 ȡ
+	enum {
+		ZMQ_RECV_EMPTY = 0,
+		ZMQ_RECV_NOT_ENABLED = -3,      // ûе EnablePullMode
+		ZMQ_RECV_BUFFER_TOO_SMALL = -4  // ͷϢŲϢڶ
+	};
+
+	// صеһϢkey Ϊ PubSub  topic  Router ĶԶ identityģʽΪ
+	typedef struct ZMQMessageView {
+		const uint8_t* data;
+		int length;
+		const uint8_t* key;
+		int key_length;
+	} ZMQMessageView;
+
 	// صͣ C# עᣩ
 	typedef void(__stdcall* MessageCallbackFunction)(const uint8_t* data, int length);
 	typedef void(__stdcall* SubMessageCallbackFunction)(const char* topic, const uint8_t* data, int length);
 	typedef void(__stdcall* RouterMessageCallbackFunction)(const uint8_t* identity, int id_len, const uint8_t* data, int data_len);
+	// status0 = ɹ1 = ʱ2 = ʧܣ3 = ͨ٣ǳɹʱ data Ϊ
+	typedef void(__stdcall* ReplyCallbackFunction)(int64_t request_id, int status, const uint8_t* data, int length);
+	typedef void(__stdcall* RouterRequestCallbackFunction)(const uint8_t* identity, int id_len, int64_t correlation_id, const uint8_t* data, int data_len);
+	// peer Ϊ Router Զ˵ĽվԶ˱̭ϿʧЧ
+	typedef void(__stdcall* RouterPeerCallbackFunction)(uint32_t peer, const uint8_t* data, int data_len);
+	// һ poll ȡϢ鼰ָڴֻڻصڼЧ
+	typedef void(__stdcall* BatchCallbackFunction)(const ZMQMessageView* messages, int count);
 
 	API ZMQSocketManager* __stdcall CreateChannel(ZMQMode mode, const char* send, const char* recv, const char* topic);
-	API void __stdcall Send(ZMQSocketManager* channel, const uint8_t* data, int length);
+	API ZMQSocketManager* __stdcall CreateChannelEx(ZMQMode mode, const char* send, const char* recv, const char* topic, const ZMQChannelOptions* options);
+	// options / socket_options Ϊ
+	API ZMQSocketManager* __stdcall CreateChannelWithSocketOptions(ZMQMode mode, const char* send, const char* recv, const char* topic,
+		const ZMQChannelOptions* options, const ZMQSocketOptions* socket_options);
+	API void __stdcall InitSocketOptions(ZMQSocketOptions* socket_options);
+	// 㲢 struct_sizeֶȡĬֵ
+	API void __stdcall InitChannelOptions(ZMQChannelOptions* options);
+	API int __stdcall Send(ZMQSocketManager* channel, const uint8_t* data, int length);
 	API void __stdcall RegisterCallback(ZMQSocketManager* channel, MessageCallbackFunction callback);
-	API void __stdcall SendWithTopic(ZMQSocketManager* channel, const uint8_t* data, int length, const char* topic);
+	API int __stdcall SendWithTopic(ZMQSocketManager* channel, const uint8_t* data, int length, const char* topic);
+	// һε÷ͶϢ˳ӣܾϢֹͣӵЧʱ ZMQ_SEND_INVALID_ARGUMENT
+	API int __stdcall SendBatch(ZMQSocketManager* channel, const uint8_t** buffers, const int* lengths, int count);
+	API int __stdcall SendBatchWithTopic(ZMQSocketManager* channel, const uint8_t** buffers, const int* lengths, int count, const char* topic);
+	//  RegisterCallback / RegisterSubCallback / RegisterRouterCallback ⣬עЧReqRep ֧
+	API void __stdcall RegisterBatchCallback(ZMQSocketManager* channel, BatchCallbackFunction callback);
+
+	// ȡģʽյϢΪ capacity ĶУ<= 0 ʹĬֵɵ÷߳ȡߣٻص
+	//  Register*Callback ⣬õЧͬһͨͬһʱֻһ߳ȡϢ
+	//  ZMQ_RESULT_OKReqRep Ȳ֧ȡģʽ ZMQ_RESULT_NOT_SUPPORTED
+	API int __stdcall EnablePullMode(ZMQSocketManager* channel, int capacity);
+	// ȴȡһϢ keytopic / identityֱ𿽱÷Ļkey Ϊ
+	//  1 ʾȡZMQ_RECV_EMPTY ʾΪգʱ ZMQ_RECV_BUFFER_TOO_SMALL*length / *key_length ΪС
+	API int __stdcall TryReceive(ZMQSocketManager* channel, uint8_t* buffer, int capacity, int* length,
+		uint8_t* key, int key_capacity, int* key_length);
+	// ȴһϢtimeout_ms < 0 һֱȴ0 ȴȻܷŽ buffer Ϣȡ max_messages 
+	// messages еָָ buffer ڲȡʱ ZMQ_RECV_EMPTY
+	API int __stdcall ReceiveMany(ZMQSocketManager* channel, uint8_t* buffer, int capacity,
+		ZMQMessageView* messages, int max_messages, int timeout_ms);
+	// зǿʱźŵľLinux Ϊ eventfdWindows Ϊ Event HANDLEɽ÷Լĵȴ
+	//  TryReceive / ReceiveMany ȡնʱλ÷Ҫȡλδȡģʽʱ -1
+	API intptr_t __stdcall GetReadyHandle(ZMQSocketManager* channel);
+	API int __stdcall GetSendQueueStats(ZMQSocketManager* channel, ZMQSendQueueStats* stats);
+	// ѷ topic ֵ buffer 1 ʾȡZMQ_RECV_EMPTY ʾûи topic δû棻
+	// ʱ ZMQ_RECV_BUFFER_TOO_SMALL*length ΪС
+	API int __stdcall GetLastValue(ZMQSocketManager* channel, const char* topic, uint8_t* buffer, int capacity, int* length);
+	API int __stdcall GetChannelMetrics(ZMQSocketManager* channel, ZMQChannelMetrics* metrics);
 	API void __stdcall RegisterSubCallback(ZMQSocketManager* channel, SubMessageCallbackFunction callback);
+	// ĶʱġSubscribe Ϣ RegisterSubCallback עĻص
+	// SubscribeWithCallback Ϣֻ callbackexact  0 ʱֻ topic ȫͬϢUnsubscribe Ƴ topic ϵȫ
+	API void __stdcall Subscribe(ZMQSocketManager* channel, const char* topic);
+	API void __stdcall SubscribeWithCallback(ZMQSocketManager* channel, const char* topic, int exact, SubMessageCallbackFunction callback);
+	API void __stdcall Unsubscribe(ZMQSocketManager* channel, const char* topic);
 	API void __stdcall SendReplierReply(ZMQSocketManager* channel, const uint8_t* data, int length);
 	API void __stdcall RegisterRouterCallback(ZMQSocketManager* channel, RouterMessageCallbackFunction callback);
 	API void __stdcall SendRouterReply(ZMQSocketManager* channel, const uint8_t* identity, int id_len, const uint8_t* data, int data_len);
+	// Dealer ˷ id 󣬷 id> 0ظʱͬһ id  callback
+	//  ZMQ_SEND_INVALID_ARGUMENT / ZMQ_SEND_REJECTED ʱصtimeout_ms <= 0 ʹĬֵ
+	API int64_t __stdcall SendRequest(ZMQSocketManager* channel, const uint8_t* data, int length, int timeout_ms, ReplyCallbackFunction callback);
+	API void __stdcall RegisterRouterRequestCallback(ZMQSocketManager* channel, RouterRequestCallbackFunction callback);
+	API void __stdcall SendRouterCorrelatedReply(ZMQSocketManager* channel, const uint8_t* identity, int id_len, int64_t correlation_id, const uint8_t* data, int data_len);
+	// շ identity RegisterRouterCallback ⣬עЧʧЧʱϢ
+	API void __stdcall RegisterRouterPeerCallback(ZMQSocketManager* channel, RouterPeerCallbackFunction callback);
+	API void __stdcall SendRouterPeerReply(ZMQSocketManager* channel, uint32_t peer, const uint8_t* data, int data_len);
 	API void __stdcall DestroyChannel(ZMQSocketManager* channel);
+
+	//  CreateChannel ֮ǰãpin_threads  0 ʱ CPU
+	API void __stdcall EnableReactorMode(int reactor_threads, int pin_threads);
+
+	//  CreateChannel / EnableReactorMode ֮ǰãֻʹ inproc ʱɴ 0ɹ 0Ѿ̫ -1
+	API int __stdcall SetIOThreads(int io_threads);
+
+	//  CreateChannel ֮ǰãasync  0 ʱʹ첽־sample_rate Ϊ·־Ĳ
+	API void __stdcall ConfigureLogging(int async, int queue_size, int sample_rate);
 }
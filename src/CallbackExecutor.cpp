@@ -0,0 +1,93 @@
+#include "CallbackExecutor.h"
+#include "LoggerManager.h"
+
+CallbackExecutor::CallbackExecutor(size_t thread_count, DispatchOrdering ordering)
+    : ordering_(ordering), dropped_(0)
+{
+    if (thread_count == 0)
+        thread_count = 1;
+
+    size_t queue_count = ordering_ == DispatchOrdering::Unordered ? 1 : thread_count;
+    for (size_t i = 0; i < queue_count; ++i) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        TaskQueue& queue = *queues_[i % queue_count];
+        threads_.emplace_back(&CallbackExecutor::worker_loop, this, std::ref(queue));
+    }
+
+    spdlog::info("[CallbackExecutor] Started, threads: {}, ordering: {}", thread_count, static_cast<int>(ordering_));
+}
+
+CallbackExecutor::~CallbackExecutor()
+{
+    stop();
+}
+
+void CallbackExecutor::submit(size_t key, Task task)
+{
+    TaskQueue& queue = *queues_[queues_.size() == 1 ? 0 : key % queues_.size()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.stopped) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        queue.tasks.push_back(std::move(task));
+    }
+    queue.not_empty.notify_one();
+}
+
+void CallbackExecutor::stop()
+{
+    std::call_once(stop_once_, [this]() {
+        for (auto& queue : queues_) {
+            {
+                std::lock_guard<std::mutex> lock(queue->mutex);
+                queue->stopped = true;
+            }
+            queue->not_empty.notify_all();
+        }
+
+        for (auto& thread : threads_) {
+            if (thread.joinable())
+                thread.join();
+        }
+
+        spdlog::info("[CallbackExecutor] Stopped");
+    });
+}
+
+size_t CallbackExecutor::pending() const
+{
+    size_t total = 0;
+    for (const auto& queue : queues_) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        total += queue->tasks.size();
+    }
+    return total;
+}
+
+void CallbackExecutor::worker_loop(TaskQueue& queue)
+{
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            queue.not_empty.wait(lock, [&queue]() { return queue.stopped || !queue.tasks.empty(); });
+            // ֹͣ԰ύִ
+            if (queue.tasks.empty())
+                break;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        try {
+            task();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("[CallbackExecutor] Callback threw: {}", e.what());
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#include "LastValueCache.h"
+
+uint64_t LastValueCache::update(const std::string& topic, zmq::message_t& msg)
+{
+    zmq::message_t value;
+    value.copy(msg);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Value& slot = values_[topic];
+    slot.message = std::move(value);
+    return ++slot.sequence;
+}
+
+bool LastValueCache::get(const std::string& topic, zmq::message_t& out, uint64_t* sequence) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = values_.find(topic);
+    if (it == values_.end())
+        return false;
+
+    out.copy(it->second.message);
+    if (sequence)
+        *sequence = it->second.sequence;
+    return true;
+}
+
+std::vector<LastValueCache::Entry> LastValueCache::snapshot(std::string_view prefix) const
+{
+    std::vector<Entry> entries;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [topic, value] : values_) {
+        if (topic.compare(0, prefix.size(), prefix) != 0)
+            continue;
+        Entry entry{ topic, value.sequence, zmq::message_t() };
+        entry.value.copy(value.message);
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+size_t LastValueCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return values_.size();
+}
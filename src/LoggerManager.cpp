@@ -1,4 +1,5 @@
 #include "LoggerManager.h"
+#include <spdlog/async.h>
 #include <mutex>
 #include <iostream>
 
@@ -6,9 +7,9 @@ namespace {
     std::once_flag initFlag;
 }
 
-void LoggerManager::Init()
+void LoggerManager::Init(const LoggerOptions& options)
 {
-    std::call_once(initFlag, []() {
+    std::call_once(initFlag, [&options]() {
         try
         {
             std::cout << "[LoggerManager] Init called" << std::endl;
@@ -16,11 +17,23 @@ void LoggerManager::Init()
             auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("Logs\\zeromq_log.txt", true);
 
             std::vector<spdlog::sink_ptr> sinks{ console_sink, file_sink };
-            auto logger = std::make_shared<spdlog::logger>("zmq", sinks.begin(), sinks.end());
+            std::shared_ptr<spdlog::logger> logger;
+            if (options.async) {
+                // ̨̰߳˳дշֻ߳һ
+                spdlog::init_thread_pool(options.async_queue_size, 1);
+                auto policy = options.async_block_when_full ? spdlog::async_overflow_policy::block
+                                                            : spdlog::async_overflow_policy::overrun_oldest;
+                logger = std::make_shared<spdlog::async_logger>("zmq", sinks.begin(), sinks.end(), spdlog::thread_pool(), policy);
+                spdlog::flush_every(std::chrono::seconds(1));
+            }
+            else {
+                logger = std::make_shared<spdlog::logger>("zmq", sinks.begin(), sinks.end());
+            }
 
             spdlog::set_default_logger(logger);
             spdlog::set_level(spdlog::level::debug);
-            spdlog::flush_on(spdlog::level::debug);
+            spdlog::flush_on(options.flush_level);
+            SetSampleRate(options.sample_rate);
         }
         catch (const spdlog::spdlog_ex& ex)
         {
@@ -34,3 +47,8 @@ void LoggerManager::SetLevel(spdlog::level::level_enum level)
     spdlog::set_level(level);
     spdlog::flush_on(level);
 }
+
+void LoggerManager::SetSampleRate(uint32_t every_n)
+{
+    sample_rate_.store(every_n, std::memory_order_relaxed);
+}
@@ -0,0 +1,96 @@
+#include "PacketBatcher.h"
+#include "LoggerManager.h"
+#include <cstring>
+
+PacketBatcher::PacketBatcher(FrameSink sink, const PacketBatchOptions& options)
+    : sink_(std::move(sink)), options_(options), packet_count_(0),
+      packets_sent_(0), batches_sent_(0), packets_dropped_(0), running_(true)
+{
+    buffer_.reserve(options_.max_batch_bytes);
+    linger_thread_ = std::thread(&PacketBatcher::linger_loop, this);
+}
+
+PacketBatcher::~PacketBatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    first_packet_.notify_all();
+
+    if (linger_thread_.joinable())
+        linger_thread_.join();
+
+    flush();
+}
+
+bool PacketBatcher::add(PayloadType type, const uint8_t* payload, size_t size)
+{
+    bool full;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t offset = buffer_.size();
+        buffer_.resize(offset + PacketBuilder::kHeaderSize + size);
+        PacketBuilder::EncodeHeader(type, static_cast<uint32_t>(size), buffer_.data() + offset);
+        if (size > 0)
+            std::memcpy(buffer_.data() + offset + PacketBuilder::kHeaderSize, payload, size);
+
+        if (packet_count_++ == 0) {
+            deadline_ = std::chrono::steady_clock::now() + options_.linger;
+            first_packet_.notify_one();
+        }
+        full = buffer_.size() >= options_.max_batch_bytes;
+    }
+
+    return full ? flush() : true;
+}
+
+bool PacketBatcher::flush()
+{
+    std::lock_guard<std::mutex> flush_lock(flush_mutex_);
+
+    std::vector<uint8_t> frame;
+    size_t count;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (packet_count_ == 0)
+            return true;
+
+        count = packet_count_;
+        packet_count_ = 0;
+        frame.swap(buffer_);
+        buffer_.reserve(options_.max_batch_bytes);
+    }
+
+    // Ȩ sinksend_async(std::move(frame)) ʱٿ
+    if (!sink_(std::move(frame))) {
+        packets_dropped_.fetch_add(count, std::memory_order_relaxed);
+        ZMQ_HOT_WARN("[PacketBatcher] Sink rejected a batch of {} packets", count);
+        return false;
+    }
+
+    packets_sent_.fetch_add(count, std::memory_order_relaxed);
+    batches_sent_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void PacketBatcher::linger_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        if (packet_count_ == 0) {
+            first_packet_.wait(lock, [this]() { return !running_ || packet_count_ > 0; });
+            continue;
+        }
+
+        auto deadline = deadline_;
+        if (std::chrono::steady_clock::now() < deadline) {
+            first_packet_.wait_until(lock, deadline);
+            continue;
+        }
+
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
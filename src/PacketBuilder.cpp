@@ -2,40 +2,76 @@
 #include <cstring>
 
 std::vector<uint8_t> PacketBuilder::BuildPacket(PayloadType type, const std::vector<uint8_t>& payload) {
-    std::vector<uint8_t> packet(1 + 4 + payload.size());
+    std::vector<uint8_t> packet(kHeaderSize + payload.size());
 
-    // 
-    packet[0] = static_cast<uint8_t>(type);
-
-    // ȣС
-    uint32_t length = static_cast<uint32_t>(payload.size());
-    packet[1] = length & 0xFF;
-    packet[2] = (length >> 8) & 0xFF;
-    packet[3] = (length >> 16) & 0xFF;
-    packet[4] = (length >> 24) & 0xFF;
+    EncodeHeader(type, static_cast<uint32_t>(payload.size()), packet.data());
 
     // 
-    std::memcpy(packet.data() + 5, payload.data(), payload.size());
+    if (!payload.empty())
+        std::memcpy(packet.data() + kHeaderSize, payload.data(), payload.size());
 
     return packet;
 }
 
 bool PacketBuilder::TryParsePacket(const std::vector<uint8_t>& packet, PayloadType& type, std::vector<uint8_t>& payload) {
-    if (packet.size() < 5)
+    ByteView payload_view;
+    if (!TryParsePacket(ByteView(packet), type, payload_view))
+        return false;
+
+    payload.assign(payload_view.begin(), payload_view.end());
+    return true;
+}
+
+void PacketBuilder::EncodeHeader(PayloadType type, uint32_t payload_length, uint8_t* out) {
+    // 
+    out[0] = static_cast<uint8_t>(type);
+
+    // ȣС
+    out[1] = payload_length & 0xFF;
+    out[2] = (payload_length >> 8) & 0xFF;
+    out[3] = (payload_length >> 16) & 0xFF;
+    out[4] = (payload_length >> 24) & 0xFF;
+}
+
+std::vector<uint8_t> PacketBuilder::AllocatePacket(size_t payload_size) {
+    return std::vector<uint8_t>(kHeaderSize + payload_size);
+}
+
+bool PacketBuilder::FinalizePacket(PayloadType type, std::vector<uint8_t>& packet) {
+    if (packet.size() < kHeaderSize)
+        return false;
+
+    EncodeHeader(type, static_cast<uint32_t>(packet.size() - kHeaderSize), packet.data());
+    return true;
+}
+
+zmq::message_t PacketBuilder::BuildMessage(PayloadType type, const uint8_t* payload, size_t size) {
+    zmq::message_t msg(kHeaderSize + size);
+    uint8_t* out = static_cast<uint8_t*>(msg.data());
+
+    EncodeHeader(type, static_cast<uint32_t>(size), out);
+    if (size > 0)
+        std::memcpy(out + kHeaderSize, payload, size);
+
+    return msg;
+}
+
+bool PacketBuilder::TryParsePacket(ByteView packet, PayloadType& type, ByteView& payload) {
+    if (packet.size() < kHeaderSize)
         return false;
 
     type = static_cast<PayloadType>(packet[0]);
 
     // ȡȣСˣ
     uint32_t length =
-        (packet[1]) |
-        (packet[2] << 8) |
-        (packet[3] << 16) |
-        (packet[4] << 24);
+        (static_cast<uint32_t>(packet[1])) |
+        (static_cast<uint32_t>(packet[2]) << 8) |
+        (static_cast<uint32_t>(packet[3]) << 16) |
+        (static_cast<uint32_t>(packet[4]) << 24);
 
-    if (packet.size() < 5 + length)
+    if (packet.size() - kHeaderSize < length)
         return false;
 
-    payload.assign(packet.begin() + 5, packet.begin() + 5 + length);
+    payload = ByteView(packet.data() + kHeaderSize, length);
     return true;
 }
@@ -0,0 +1,120 @@
+#include "ReceiveQueue.h"
+#include "LoggerManager.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+ReceiveQueue::ReceiveQueue(size_t capacity)
+    : ring_(capacity), handle_(-1), signaled_(false), dropped_(0)
+{
+#ifdef _WIN32
+    HANDLE event = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!event)
+        throw std::runtime_error("CreateEvent failed: " + std::to_string(GetLastError()));
+    handle_ = reinterpret_cast<intptr_t>(event);
+#else
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0)
+        throw std::runtime_error(std::string("eventfd failed: ") + std::strerror(errno));
+    handle_ = fd;
+#endif
+    spdlog::debug("[ReceiveQueue] Created, capacity: {}", ring_.capacity());
+}
+
+ReceiveQueue::~ReceiveQueue()
+{
+#ifdef _WIN32
+    CloseHandle(reinterpret_cast<HANDLE>(handle_));
+#else
+    close(static_cast<int>(handle_));
+#endif
+}
+
+bool ReceiveQueue::push(std::string_view key, zmq::message_t&& data)
+{
+    Entry entry{ std::string(key), std::move(data) };
+    if (!ring_.try_push(entry)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        ZMQ_HOT_WARN("[ReceiveQueue] Queue full, message dropped");
+        return false;
+    }
+
+    //  rearm ǺĸԣһԷ޸
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!signaled_.load(std::memory_order_relaxed) && !signaled_.exchange(true))
+        signal();
+    return true;
+}
+
+ReceiveQueue::Entry* ReceiveQueue::front()
+{
+    Entry* entry = ring_.front();
+    if (!entry) {
+        rearm();
+        entry = ring_.front();
+    }
+    return entry;
+}
+
+void ReceiveQueue::pop()
+{
+    ring_.pop();
+}
+
+bool ReceiveQueue::wait(std::chrono::milliseconds timeout)
+{
+    if (front())
+        return true;
+
+#ifdef _WIN32
+    DWORD wait_ms = timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count());
+    WaitForSingleObject(reinterpret_cast<HANDLE>(handle_), wait_ms);
+#else
+    pollfd item = { static_cast<int>(handle_), POLLIN, 0 };
+    int wait_ms = timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+    while (poll(&item, 1, wait_ms) < 0 && errno == EINTR) {
+    }
+#endif
+    return ring_.front() != nullptr;
+}
+
+void ReceiveQueue::signal()
+{
+#ifdef _WIN32
+    SetEvent(reinterpret_cast<HANDLE>(handle_));
+#else
+    uint64_t one = 1;
+    ssize_t written = write(static_cast<int>(handle_), &one, sizeof(one));
+    (void)written;
+#endif
+}
+
+void ReceiveQueue::rearm()
+{
+    if (!signaled_.load(std::memory_order_relaxed))
+        return;
+
+    // ȸλǣ˼ӵ߿Ϊ true ظ֪ͨĸ鲹
+#ifdef _WIN32
+    ResetEvent(reinterpret_cast<HANDLE>(handle_));
+#else
+    uint64_t count;
+    ssize_t read_bytes = read(static_cast<int>(handle_), &count, sizeof(count));
+    (void)read_bytes;
+#endif
+    signaled_.exchange(false);
+
+    if (!ring_.empty() && !signaled_.exchange(true))
+        signal();
+}
@@ -0,0 +1,38 @@
+#include "RetransmitBuffer.h"
+
+RetransmitBuffer::RetransmitBuffer(size_t depth)
+    : depth_(depth == 0 ? 1 : depth)
+{
+}
+
+void RetransmitBuffer::store(const std::string& topic, uint64_t sequence, zmq::message_t& msg)
+{
+    std::vector<Slot>& ring = rings_[topic];
+    if (ring.empty())
+        ring.resize(depth_);
+
+    Slot& slot = ring[sequence % depth_];
+    slot.sequence = sequence;
+    slot.message.copy(msg);
+}
+
+void RetransmitBuffer::collect(const std::string& topic, uint64_t from, uint64_t to, std::vector<Entry>& out)
+{
+    auto it = rings_.find(topic);
+    if (it == rings_.end() || from == 0 || from > to)
+        return;
+
+    // ֻ depth 
+    if (to - from >= depth_)
+        from = to - depth_ + 1;
+
+    std::vector<Slot>& ring = it->second;
+    for (uint64_t sequence = from; sequence <= to; ++sequence) {
+        Slot& slot = ring[sequence % depth_];
+        if (slot.sequence != sequence)
+            continue;
+        Entry entry{ sequence, zmq::message_t() };
+        entry.value.copy(slot.message);
+        out.push_back(std::move(entry));
+    }
+}
@@ -0,0 +1,204 @@
+#include "RouterIdentityTable.h"
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace {
+    size_t bucket_count_for(size_t capacity)
+    {
+        size_t count = 16;
+        while (count < capacity * 2)
+            count <<= 1;
+        return count;
+    }
+}
+
+RouterIdentityTable::RouterIdentityTable(size_t capacity)
+    : entries_((std::min)((std::max)(capacity, size_t(1)), kMaxCapacity)),
+      buckets_(bucket_count_for(entries_.size()), kNone)
+{
+    // ѹ룬±СĿ
+    free_.reserve(entries_.size());
+    for (size_t i = entries_.size(); i > 0; --i)
+        free_.push_back(static_cast<uint32_t>(i - 1));
+}
+
+RouterIdentityTable::Handle RouterIdentityTable::intern(ByteView identity)
+{
+    uint64_t hash = hash_of(identity);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint32_t index = lookup(identity, hash);
+    if (index != kNone) {
+        if (head_ != index) {
+            unlink(index);
+            push_front(index);
+        }
+        return handle_of(index);
+    }
+
+    if (free_.empty())
+        remove(tail_);
+    index = free_.back();
+    free_.pop_back();
+
+    Entry& entry = entries_[index];
+    entry.identity.assign(reinterpret_cast<const char*>(identity.data()), identity.size());
+    entry.hash = hash;
+    entry.used = true;
+    push_front(index);
+
+    size_t mask = buckets_.size() - 1;
+    size_t bucket = static_cast<size_t>(hash) & mask;
+    while (buckets_[bucket] != kNone)
+        bucket = (bucket + 1) & mask;
+    buckets_[bucket] = index;
+    ++size_;
+    return handle_of(index);
+}
+
+RouterIdentityTable::Handle RouterIdentityTable::find(ByteView identity) const
+{
+    uint64_t hash = hash_of(identity);
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t index = lookup(identity, hash);
+    return index == kNone ? kInvalidHandle : handle_of(index);
+}
+
+bool RouterIdentityTable::resolve(Handle handle, zmq::message_t& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry* entry = entry_of(handle);
+    if (!entry)
+        return false;
+    out.rebuild(entry->identity.data(), entry->identity.size());
+    return true;
+}
+
+bool RouterIdentityTable::resolve(Handle handle, std::vector<uint8_t>& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry* entry = entry_of(handle);
+    if (!entry)
+        return false;
+    out.assign(entry->identity.begin(), entry->identity.end());
+    return true;
+}
+
+void RouterIdentityTable::evict(ByteView identity)
+{
+    uint64_t hash = hash_of(identity);
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t index = lookup(identity, hash);
+    if (index != kNone)
+        remove(index);
+}
+
+void RouterIdentityTable::retire(Handle handle)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!entry_of(handle))
+        return;
+
+    uint32_t index = handle & kIndexMask;
+    if (tail_ == index)
+        return;
+    unlink(index);
+
+    Entry& entry = entries_[index];
+    entry.prev = tail_;
+    entries_[tail_].next = index;
+    tail_ = index;
+}
+
+size_t RouterIdentityTable::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+uint64_t RouterIdentityTable::hash_of(ByteView identity)
+{
+    return std::hash<std::string_view>()(identity.as_string());
+}
+
+RouterIdentityTable::Handle RouterIdentityTable::handle_of(uint32_t index) const
+{
+    return (entries_[index].generation << kIndexBits) | index;
+}
+
+const RouterIdentityTable::Entry* RouterIdentityTable::entry_of(Handle handle) const
+{
+    uint32_t index = handle & kIndexMask;
+    if (handle == kInvalidHandle || index >= entries_.size())
+        return nullptr;
+    const Entry& entry = entries_[index];
+    if (!entry.used || handle_of(index) != handle)
+        return nullptr;
+    return &entry;
+}
+
+uint32_t RouterIdentityTable::lookup(ByteView identity, uint64_t hash) const
+{
+    size_t mask = buckets_.size() - 1;
+    for (size_t bucket = static_cast<size_t>(hash) & mask; buckets_[bucket] != kNone; bucket = (bucket + 1) & mask) {
+        const Entry& entry = entries_[buckets_[bucket]];
+        if (entry.hash == hash && std::string_view(entry.identity) == identity.as_string())
+            return buckets_[bucket];
+    }
+    return kNone;
+}
+
+void RouterIdentityTable::remove(uint32_t index)
+{
+    Entry& entry = entries_[index];
+    size_t mask = buckets_.size() - 1;
+    size_t hole = static_cast<size_t>(entry.hash) & mask;
+    while (buckets_[hole] != index)
+        hole = (hole + 1) & mask;
+
+    // ɾѺ治λϵĿǰ̽ϲĹ
+    for (size_t next = (hole + 1) & mask; buckets_[next] != kNone; next = (next + 1) & mask) {
+        size_t ideal = static_cast<size_t>(entries_[buckets_[next]].hash) & mask;
+        if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+            buckets_[hole] = buckets_[next];
+            hole = next;
+        }
+    }
+    buckets_[hole] = kNone;
+
+    unlink(index);
+    entry.used = false;
+    entry.identity.clear();  // Ŀʱٷ
+    uint32_t generation = (entry.generation + 1) & (UINT32_MAX >> kIndexBits);
+    entry.generation = generation == 0 ? 1 : generation;
+    free_.push_back(index);
+    --size_;
+}
+
+void RouterIdentityTable::unlink(uint32_t index)
+{
+    Entry& entry = entries_[index];
+    if (entry.prev != kNone)
+        entries_[entry.prev].next = entry.next;
+    else
+        head_ = entry.next;
+    if (entry.next != kNone)
+        entries_[entry.next].prev = entry.prev;
+    else
+        tail_ = entry.prev;
+    entry.prev = kNone;
+    entry.next = kNone;
+}
+
+void RouterIdentityTable::push_front(uint32_t index)
+{
+    Entry& entry = entries_[index];
+    entry.prev = kNone;
+    entry.next = head_;
+    if (head_ != kNone)
+        entries_[head_].prev = index;
+    head_ = index;
+    if (tail_ == kNone)
+        tail_ = index;
+}
@@ -0,0 +1,292 @@
+#include "SharedMemoryRing.h"
+#include "LoggerManager.h"
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ڹڴ濪ͷ߸޸ĵֶηڲͬĻ
+struct SharedMemoryRing::Header {
+    std::atomic<uint32_t> state;  // 0 = δʼ1 = ʼУ2 = 
+    uint32_t version;
+    uint64_t capacity;
+
+    alignas(64) std::atomic<uint64_t> head;  // дλãֻ޸
+    std::atomic<uint64_t> records_written;
+
+    alignas(64) std::atomic<uint64_t> tail;  // ȡλã޸
+    std::atomic<uint64_t> records_read;
+
+    alignas(64) std::atomic<uint32_t> consumer_waiting;
+};
+
+namespace {
+    constexpr uint32_t kStateReady = 2;
+    constexpr uint32_t kLayoutVersion = 1;
+    constexpr size_t kDataOffset = 4096;  // ҳ
+    constexpr auto kAttachTimeout = std::chrono::seconds(1);
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory ring needs lock-free 64-bit atomics");
+
+    size_t round_up_pow2(size_t value)
+    {
+        size_t size = 4096;
+        while (size < value)
+            size <<= 1;
+        return size;
+    }
+
+#ifdef _WIN32
+    std::string os_name(const std::string& name) { return "Local\\zmq-shm-" + name; }
+#else
+    std::string os_name(const std::string& name) { return "/zmq-shm-" + name; }
+#endif
+}
+
+SharedMemoryRing::SharedMemoryRing(const std::string& name, const SharedMemoryOptions& options)
+    : name_(name), options_(options), mapping_(nullptr), mapping_size_(0), handle_(-1),
+      header_(nullptr), data_(nullptr), capacity_(0)
+{
+    static_assert(sizeof(Header) <= kDataOffset, "ring header must fit before the data area");
+
+    size_t requested = round_up_pow2(options.ring_bytes);
+    bool created = false;
+
+#ifdef _WIN32
+    uint64_t total = kDataOffset + requested;
+    HANDLE handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(total >> 32), static_cast<DWORD>(total), os_name(name).c_str());
+    if (!handle)
+        throw std::runtime_error("CreateFileMapping failed for " + name + ": " + std::to_string(GetLastError()));
+    created = GetLastError() != ERROR_ALREADY_EXISTS;
+    handle_ = reinterpret_cast<intptr_t>(handle);
+    // ѴڵӳôĴСӳ
+    map(created ? static_cast<size_t>(total) : 0);
+#else
+    int fd = shm_open(os_name(name).c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd >= 0) {
+        created = true;
+        if (ftruncate(fd, static_cast<off_t>(kDataOffset + requested)) != 0) {
+            int error = errno;
+            close(fd);
+            shm_unlink(os_name(name).c_str());
+            throw std::runtime_error("ftruncate failed for " + name + ": " + std::strerror(error));
+        }
+    }
+    else if (errno == EEXIST) {
+        fd = shm_open(os_name(name).c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0)
+        throw std::runtime_error("shm_open failed for " + name + ": " + std::strerror(errno));
+    handle_ = fd;
+
+    // ܻûü ftruncate
+    struct stat st;
+    auto deadline = std::chrono::steady_clock::now() + kAttachTimeout;
+    while (fstat(fd, &st) == 0 && st.st_size <= static_cast<off_t>(kDataOffset) && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    map(static_cast<size_t>(st.st_size));
+#endif
+
+    header_ = static_cast<Header*>(mapping_);
+    data_ = static_cast<uint8_t*>(mapping_) + kDataOffset;
+
+    if (created) {
+        header_->version = kLayoutVersion;
+        header_->capacity = mapping_size_ - kDataOffset;
+        header_->head.store(0, std::memory_order_relaxed);
+        header_->records_written.store(0, std::memory_order_relaxed);
+        header_->tail.store(0, std::memory_order_relaxed);
+        header_->records_read.store(0, std::memory_order_relaxed);
+        header_->consumer_waiting.store(0, std::memory_order_relaxed);
+        header_->state.store(kStateReady, std::memory_order_release);
+    }
+    else {
+        auto deadline = std::chrono::steady_clock::now() + kAttachTimeout;
+        while (header_->state.load(std::memory_order_acquire) != kStateReady && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        if (header_->state.load(std::memory_order_acquire) != kStateReady || header_->version != kLayoutVersion
+            || header_->capacity + kDataOffset > mapping_size_) {
+            unmap();
+            throw std::runtime_error("shared memory segment " + name + " is not a valid ring, remove it and retry");
+        }
+    }
+
+    capacity_ = static_cast<size_t>(header_->capacity);
+    spdlog::info("[SharedMemoryRing] {} {}, capacity: {} bytes", created ? "Created" : "Attached to", name_, capacity_);
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    unmap();
+    if (options_.remove_on_close)
+        remove(name_);
+}
+
+void SharedMemoryRing::map(size_t mapping_size)
+{
+#ifdef _WIN32
+    HANDLE handle = reinterpret_cast<HANDLE>(handle_);
+    mapping_ = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, mapping_size);
+    if (!mapping_) {
+        DWORD error = GetLastError();
+        CloseHandle(handle);
+        throw std::runtime_error("MapViewOfFile failed for " + name_ + ": " + std::to_string(error));
+    }
+
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(mapping_, &info, sizeof(info));
+    mapping_size_ = info.RegionSize;
+#else
+    if (mapping_size <= kDataOffset) {
+        close(static_cast<int>(handle_));
+        throw std::runtime_error("shared memory segment " + name_ + " was never sized");
+    }
+
+    mapping_ = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, static_cast<int>(handle_), 0);
+    if (mapping_ == MAP_FAILED) {
+        int error = errno;
+        mapping_ = nullptr;
+        close(static_cast<int>(handle_));
+        throw std::runtime_error("mmap failed for " + name_ + ": " + std::strerror(error));
+    }
+    mapping_size_ = mapping_size;
+#endif
+}
+
+void SharedMemoryRing::unmap()
+{
+#ifdef _WIN32
+    if (mapping_)
+        UnmapViewOfFile(mapping_);
+    CloseHandle(reinterpret_cast<HANDLE>(handle_));
+#else
+    if (mapping_)
+        munmap(mapping_, mapping_size_);
+    close(static_cast<int>(handle_));
+#endif
+    mapping_ = nullptr;
+    header_ = nullptr;
+}
+
+void SharedMemoryRing::remove(const std::string& name)
+{
+#ifndef _WIN32
+    shm_unlink(os_name(name).c_str());
+#else
+    (void)name;
+#endif
+}
+
+bool SharedMemoryRing::try_write(const uint8_t* data, size_t size)
+{
+    if (size > max_message_size())
+        return false;
+
+    uint64_t head = header_->head.load(std::memory_order_relaxed);
+    uint64_t tail = header_->tail.load(std::memory_order_acquire);
+    size_t offset = static_cast<size_t>(head & (capacity_ - 1));
+    size_t needed = record_size(size);
+
+    // βʣռŲʱдһƱǣ¼ӻĿͷʼ
+    size_t skip = capacity_ - offset < needed ? capacity_ - offset : 0;
+    if (head + skip + needed - tail > capacity_)
+        return false;
+
+    if (skip > 0) {
+        uint32_t marker = kWrapMarker;
+        std::memcpy(data_ + offset, &marker, sizeof(marker));
+        offset = 0;
+    }
+
+    uint32_t length = static_cast<uint32_t>(size);
+    std::memcpy(data_ + offset, &length, sizeof(length));
+    if (size > 0)
+        std::memcpy(data_ + offset + kRecordHeaderSize, data, size);
+
+    header_->records_written.store(header_->records_written.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    // seq_cstߵ begin_wait ԣ֤һԷ޸
+    header_->head.store(head + skip + needed, std::memory_order_seq_cst);
+    return true;
+}
+
+bool SharedMemoryRing::peek(ByteView& out)
+{
+    for (;;) {
+        uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+        uint64_t head = header_->head.load(std::memory_order_acquire);
+        if (tail == head)
+            return false;
+
+        size_t offset = static_cast<size_t>(tail & (capacity_ - 1));
+        uint32_t length;
+        std::memcpy(&length, data_ + offset, sizeof(length));
+        if (length == kWrapMarker) {
+            header_->tail.store(tail + (capacity_ - offset), std::memory_order_release);
+            continue;
+        }
+
+        out = ByteView(data_ + offset + kRecordHeaderSize, length);
+        return true;
+    }
+}
+
+void SharedMemoryRing::pop()
+{
+    uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    size_t offset = static_cast<size_t>(tail & (capacity_ - 1));
+    uint32_t length;
+    std::memcpy(&length, data_ + offset, sizeof(length));
+
+    header_->records_read.store(header_->records_read.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    // release߿µ tail ֮ǰ¼Ѿ
+    header_->tail.store(tail + record_size(length), std::memory_order_release);
+}
+
+bool SharedMemoryRing::empty() const
+{
+    return header_->tail.load(std::memory_order_relaxed) == header_->head.load(std::memory_order_acquire);
+}
+
+uint64_t SharedMemoryRing::queued() const
+{
+    uint64_t read = header_->records_read.load(std::memory_order_relaxed);
+    uint64_t written = header_->records_written.load(std::memory_order_relaxed);
+    return written > read ? written - read : 0;
+}
+
+bool SharedMemoryRing::begin_wait()
+{
+    header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+    if (header_->tail.load(std::memory_order_relaxed) != header_->head.load(std::memory_order_seq_cst)) {
+        end_wait();
+        return false;
+    }
+    return true;
+}
+
+void SharedMemoryRing::end_wait()
+{
+    header_->consumer_waiting.store(0, std::memory_order_relaxed);
+}
+
+bool SharedMemoryRing::consumer_needs_wakeup()
+{
+    // ȶһι˵ûеȴÿд붼ռ
+    return header_->consumer_waiting.load(std::memory_order_seq_cst) != 0
+        && header_->consumer_waiting.exchange(0, std::memory_order_seq_cst) != 0;
+}
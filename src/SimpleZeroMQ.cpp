@@ -177,6 +177,33 @@ void run_dealer() {
     std::this_thread::sleep_for(std::chrono::seconds(10)); // 等待服务器响应
 }
 
+// 同一进程内的 Router/Dealer：inproc 不经过 TCP 协议栈，Dealer 可以先于 Router 创建
+void run_inproc() {
+    const std::string endpoint = ZMQEndpoint::inproc("demo-router");
+
+    ZMQSocketManager dealer(ZMQMode::DealerRouter, endpoint, "");
+    dealer.set_callback([](const std::vector<uint8_t>& msg) {
+        std::string content(msg.begin(), msg.end());
+        std::cout << "[Dealer] Received reply: " << content << std::endl;
+        });
+
+    ZMQSocketManager router(ZMQMode::DealerRouter, "", endpoint);
+    router.set_router_callback([&router](const std::vector<uint8_t>& id, const std::vector<uint8_t>& msg) {
+        std::string content(msg.begin(), msg.end());
+        std::cout << "[Router] Received: " << content << std::endl;
+
+        std::string reply = "Ack: " + content;
+        router.send_router_reply(id, std::vector<uint8_t>(reply.begin(), reply.end()));
+        });
+
+    for (int i = 1; i <= 3; ++i) {
+        std::string message = "Ping " + std::to_string(i);
+        dealer.send_async(std::vector<uint8_t>(message.begin(), message.end()));
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+}
+
 int main(int argc, char* argv[])
 {
     if (argc < 2) {
@@ -215,12 +242,17 @@ int main(int argc, char* argv[])
     else if (mode == "pull") {
         run_pull();
     }
+    else if (mode == "inproc") {
+        // 只用 inproc，不需要 I/O 线程
+        ZMQSocketManager::set_io_threads(0);
+        run_inproc();
+    }
     else if (mode == "test") {
         
     }
     else {
         std::cout << "Unknown mode: " << mode << std::endl;
-        std::cout << "Usage: program.exe [server|client|dealer|router|pub|sub|test]" << std::endl;
+        std::cout << "Usage: program.exe [server|client|dealer|router|pub|sub|inproc|test]" << std::endl;
         return 1;
     }
 
@@ -0,0 +1,147 @@
+#include "SocketMetrics.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    int HighestBit(uint64_t value)
+    {
+        int bit = 0;
+        while (value >>= 1)
+            ++bit;
+        return bit;
+    }
+
+    uint64_t ValueAtPercentile(const HistogramCounts& counts, double percentile)
+    {
+        uint64_t target = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(counts.count) + 0.5);
+        target = (std::max<uint64_t>)(target, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.buckets.size(); ++i) {
+            seen += counts.buckets[i];
+            if (seen >= target)
+                return (std::min)(LatencyHistogram::BucketUpperBound(i), counts.max);
+        }
+        return counts.max;
+    }
+}
+
+LatencySnapshot HistogramCounts::summarize() const
+{
+    LatencySnapshot result;
+    if (count == 0)
+        return result;
+
+    result.count = count;
+    result.min_ns = min;
+    result.max_ns = max;
+    result.mean_ns = sum / count;
+    result.p50_ns = ValueAtPercentile(*this, 50.0);
+    result.p90_ns = ValueAtPercentile(*this, 90.0);
+    result.p99_ns = ValueAtPercentile(*this, 99.0);
+    result.p999_ns = ValueAtPercentile(*this, 99.9);
+    return result;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : count_(0), sum_(0), min_((std::numeric_limits<uint64_t>::max)()), max_(0)
+{
+    for (auto& bucket : buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+size_t LatencyHistogram::BucketIndex(uint64_t value)
+{
+    if (value < kSubBucketCount)
+        return static_cast<size_t>(value);
+
+    int exponent = HighestBit(value);
+    if (exponent > kMaxExponent)
+        return kBucketCount - 1;
+
+    size_t sub_bucket = static_cast<size_t>(value >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+    return static_cast<size_t>(exponent - kSubBucketBits + 1) * kSubBucketCount + sub_bucket;
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index)
+{
+    if (index < kSubBucketCount)
+        return index;
+
+    size_t block = index / kSubBucketCount;  // >= 1
+    uint64_t sub_bucket = index % kSubBucketCount;
+    uint64_t width = uint64_t(1) << (block - 1);
+    return ((kSubBucketCount + sub_bucket) << (block - 1)) + width - 1;
+}
+
+void LatencyHistogram::record(uint64_t value_ns)
+{
+    buckets_[BucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value_ns, std::memory_order_relaxed);
+
+    uint64_t current = min_.load(std::memory_order_relaxed);
+    while (value_ns < current && !min_.compare_exchange_weak(current, value_ns, std::memory_order_relaxed)) {
+    }
+    current = max_.load(std::memory_order_relaxed);
+    while (value_ns > current && !max_.compare_exchange_weak(current, value_ns, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::add_to(HistogramCounts& out) const
+{
+    uint64_t count = count_.load(std::memory_order_relaxed);
+    if (count == 0)
+        return;
+
+    if (out.buckets.empty())
+        out.buckets.assign(kBucketCount, 0);
+
+    //  record ʱֶομ¼ΪݿԽ
+    for (size_t i = 0; i < kBucketCount; ++i)
+        out.buckets[i] += buckets_[i].load(std::memory_order_relaxed);
+
+    uint64_t min = min_.load(std::memory_order_relaxed);
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    out.min = out.count == 0 ? min : (std::min)(out.min, min);
+    out.max = (std::max)(out.max, max);
+    out.count += count;
+    out.sum += sum_.load(std::memory_order_relaxed);
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const
+{
+    HistogramCounts counts;
+    add_to(counts);
+    return counts.summarize();
+}
+
+SocketMetricsSnapshot SocketMetrics::snapshot() const
+{
+    SocketMetricsCollector collector;
+    collector.add(*this);
+    return collector.result();
+}
+
+void SocketMetricsCollector::add(const SocketMetrics& metrics)
+{
+    totals_.messages_sent += metrics.messages_sent_.load(std::memory_order_relaxed);
+    totals_.bytes_sent += metrics.bytes_sent_.load(std::memory_order_relaxed);
+    totals_.messages_received += metrics.messages_received_.load(std::memory_order_relaxed);
+    totals_.bytes_received += metrics.bytes_received_.load(std::memory_order_relaxed);
+    totals_.send_failures += metrics.send_failures_.load(std::memory_order_relaxed);
+    totals_.retries += metrics.retries_.load(std::memory_order_relaxed);
+    totals_.timeouts += metrics.timeouts_.load(std::memory_order_relaxed);
+    totals_.lost += metrics.lost_.load(std::memory_order_relaxed);
+    totals_.queue_high_water = (std::max)(totals_.queue_high_water, metrics.queue_high_water_.load(std::memory_order_relaxed));
+    metrics.enqueue_to_wire_.add_to(enqueue_to_wire_);
+    metrics.callback_duration_.add_to(callback_duration_);
+}
+
+SocketMetricsSnapshot SocketMetricsCollector::result() const
+{
+    SocketMetricsSnapshot result = totals_;
+    result.enqueue_to_wire = enqueue_to_wire_.summarize();
+    result.callback_duration = callback_duration_.summarize();
+    return result;
+}
@@ -0,0 +1,159 @@
+#include "ThreadSafeShmPuller.h"
+#include "ZMQEndpoint.h"
+#include "LoggerManager.h"
+
+namespace {
+    constexpr int kSpinBeforeWait = 64;  // ǰϢÿ߻֪ͨ
+    // ֪ͨڽն bind ֮ǰʧڼ鶵
+    constexpr auto kIdleCheckInterval = std::chrono::milliseconds(100);
+}
+
+ThreadSafeShmPuller::ThreadSafeShmPuller(zmq::context_t& context, const std::string& name, ZMQReactor* reactor,
+    const SharedMemoryOptions& shm_options)
+    : running_(true), reactor_(reactor), reactor_id_(-1), timer_id_(-1),
+      alive_(std::make_shared<std::atomic<bool>>(true)), name_(name)
+{
+    ring_ = std::make_unique<SharedMemoryRing>(name, shm_options);
+
+    doorbell_ = std::make_unique<zmq::socket_t>(context, ZMQ_PULL);
+    doorbell_->set(zmq::sockopt::linger, 0);
+    doorbell_->bind(ZMQEndpoint::ipc("zmq-shm-" + name));
+    spdlog::info("[ShmPuller] Reading from shared memory ring: {}", name);
+
+    if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*doorbell_, ZMQ_POLLIN, [this](short) { on_reactor_doorbell(); });
+        timer_id_ = reactor_->add_timer(kIdleCheckInterval, [this]() { on_reactor_doorbell(); });
+    }
+    else {
+        receiver_thread_ = std::thread(&ThreadSafeShmPuller::puller_loop, this);
+    }
+}
+
+ThreadSafeShmPuller::~ThreadSafeShmPuller()
+{
+    running_ = false;
+    alive_->store(false);
+
+    if (reactor_) {
+        reactor_->remove_timer(timer_id_);
+        reactor_->remove_socket(reactor_id_);
+    }
+
+    if (receiver_thread_.joinable())
+        receiver_thread_.join();
+
+    doorbell_->close();
+    ring_.reset();
+    spdlog::info("[ShmPuller] Shared memory ring {} closed", name_);
+}
+
+void ThreadSafeShmPuller::set_callback(MessageCallback callback)
+{
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    message_callback_ = std::move(callback);
+}
+
+void ThreadSafeShmPuller::set_view_callback(ViewCallback callback)
+{
+    message_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    view_callback_ = std::move(callback);
+}
+
+void ThreadSafeShmPuller::set_message_callback(OwnedMessageCallback callback)
+{
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    owned_callback_ = std::move(callback);
+}
+
+void ThreadSafeShmPuller::set_batch_end_callback(std::function<void()> callback)
+{
+    batch_end_callback_ = std::move(callback);
+}
+
+void ThreadSafeShmPuller::puller_loop()
+{
+    while (running_) {
+        if (receive_batch(ZMQReactor::kMaxReceiveBatch) > 0)
+            continue;
+
+        bool idle = true;
+        for (int i = 0; i < kSpinBeforeWait && idle; ++i) {
+            std::this_thread::yield();
+            idle = ring_->empty();
+        }
+        if (!idle || !ring_->begin_wait())
+            continue;
+
+        zmq::pollitem_t items[] = {
+            { static_cast<void*>(*doorbell_), 0, ZMQ_POLLIN, 0 }
+        };
+        zmq::poll(items, 1, kIdleCheckInterval);
+        ring_->end_wait();
+
+        if (items[0].revents & ZMQ_POLLIN)
+            drain_doorbell();
+    }
+    spdlog::debug("[ShmPuller] exit receiver_loop");
+}
+
+void ThreadSafeShmPuller::on_reactor_doorbell()
+{
+    drain_doorbell();
+    ring_->end_wait();
+
+    if (receive_batch(ZMQReactor::kMaxReceiveBatch) == ZMQReactor::kMaxReceiveBatch || !ring_->begin_wait()) {
+        // ݣó reactor ̣߳һټ
+        ring_->end_wait();
+        auto alive = alive_;
+        reactor_->post([this, alive]() {
+            if (alive->load())
+                on_reactor_doorbell();
+            });
+    }
+}
+
+void ThreadSafeShmPuller::drain_doorbell()
+{
+    zmq::message_t signal;
+    while (doorbell_->recv(signal, zmq::recv_flags::dontwait)) {
+    }
+}
+
+size_t ThreadSafeShmPuller::receive_batch(size_t max_records)
+{
+    size_t count = 0;
+    ByteView data;
+    while (count < max_records && ring_->peek(data)) {
+        deliver(data);
+        ring_->pop();
+        ++count;
+    }
+    if (count > 0 && batch_end_callback_)
+        batch_end_callback_();
+    return count;
+}
+
+void ThreadSafeShmPuller::deliver(ByteView data)
+{
+    auto callback_start = SocketMetrics::Clock::now();
+    // 쳣 popͬһ¼ᱻͶ
+    try {
+        if (owned_callback_) {
+            owned_callback_(zmq::message_t(data.data(), data.size()));
+        }
+        else if (view_callback_) {
+            view_callback_(data);
+        }
+        else if (message_callback_) {
+            message_callback_(data.to_vector());
+        }
+    }
+    catch (const std::exception& e) {
+        spdlog::error("[ShmPuller] Callback threw: {}", e.what());
+    }
+    metrics_.on_received(data.size(), callback_start);
+    ZMQ_HOT_INFO("[ShmPuller] Received data size: {}", data.size());
+}
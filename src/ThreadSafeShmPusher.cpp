@@ -0,0 +1,103 @@
+#include "ThreadSafeShmPusher.h"
+#include "ZMQEndpoint.h"
+#include "LoggerManager.h"
+#include <thread>
+
+namespace {
+    constexpr auto kFullRetryInterval = std::chrono::microseconds(50);
+}
+
+ThreadSafeShmPusher::ThreadSafeShmPusher(zmq::context_t& context, const std::string& name, const SendQueueOptions& queue_options,
+    const SharedMemoryOptions& shm_options)
+    : overflow_(queue_options.overflow), running_(true), dropped_(0), rejected_(0), name_(name)
+{
+    ring_ = std::make_unique<SharedMemoryRing>(name, shm_options);
+
+    // ն bindȺ˳ޣ֪ͨҲûϵն˻ᶨڼ
+    doorbell_ = std::make_unique<zmq::socket_t>(context, ZMQ_PUSH);
+    doorbell_->set(zmq::sockopt::linger, 0);
+    doorbell_->set(zmq::sockopt::sndhwm, 16);
+    doorbell_->connect(ZMQEndpoint::ipc("zmq-shm-" + name));
+    spdlog::info("[ShmPusher] Writing to shared memory ring: {}", name);
+}
+
+ThreadSafeShmPusher::~ThreadSafeShmPusher()
+{
+    running_ = false;
+
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    doorbell_->close();
+    ring_.reset();
+    spdlog::info("[ShmPusher] Shared memory ring {} closed", name_);
+}
+
+bool ThreadSafeShmPusher::send_async(const std::vector<uint8_t>& data)
+{
+    return send_async(data.data(), data.size());
+}
+
+bool ThreadSafeShmPusher::send_async(zmq::message_t&& msg)
+{
+    return send_async(static_cast<const uint8_t*>(msg.data()), msg.size());
+}
+
+bool ThreadSafeShmPusher::send_async(const uint8_t* data, size_t size)
+{
+    if (size > ring_->max_message_size()) {
+        ZMQ_HOT_WARN("[ShmPusher] Message of {} bytes exceeds ring limit {}", size, ring_->max_message_size());
+        ++rejected_;
+        metrics_.on_send_failure();
+        return false;
+    }
+
+    auto enqueued_at = SocketMetrics::Clock::now();
+    std::unique_lock<std::mutex> lock(write_mutex_);
+    if (!ring_->try_write(data, size)) {
+        switch (overflow_) {
+        case OverflowPolicy::Block:
+            if (!wait_for_space(data, size)) {
+                ++rejected_;
+                return false;
+            }
+            break;
+
+        case OverflowPolicy::DropNewest:
+        case OverflowPolicy::DropOldest:
+            ++dropped_;
+            return true;
+
+        case OverflowPolicy::Fail:
+            ++rejected_;
+            return false;
+        }
+    }
+
+    if (ring_->consumer_needs_wakeup()) {
+        uint8_t signal = 1;
+        doorbell_->send(zmq::const_buffer(&signal, 1), zmq::send_flags::dontwait);
+    }
+    lock.unlock();
+
+    metrics_.on_sent(size, enqueued_at);
+    return true;
+}
+
+bool ThreadSafeShmPusher::wait_for_space(const uint8_t* data, size_t size)
+{
+    // ն˲֪ͨпλߺԣд˳˳һ
+    while (running_) {
+        std::this_thread::sleep_for(kFullRetryInterval);
+        if (ring_->try_write(data, size))
+            return true;
+    }
+    return false;
+}
+
+SendQueueStats ThreadSafeShmPusher::queue_stats() const
+{
+    SendQueueStats result;
+    result.queued = static_cast<size_t>(ring_->queued());
+    result.dropped = dropped_.load(std::memory_order_relaxed);
+    result.rejected = rejected_.load(std::memory_order_relaxed);
+    return result;
+}
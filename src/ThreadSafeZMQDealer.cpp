@@ -1,111 +1,431 @@
 #include "ThreadSafeZMQDealer.h"
 #include "LoggerManager.h"
+#include <algorithm>
+#include <cstring>
 
-ThreadSafeZMQDealer::ThreadSafeZMQDealer(zmq::context_t& context, const std::string& address)
-    : context_(context), address_(address), running_(true) {
+namespace {
+    constexpr auto kReceiveTimeout = std::chrono::milliseconds(2000);
+    // ʱʱ֣10ms ȣ512 λԼ 5 룬ĳʱȦ
+    constexpr auto kRequestTimerTick = std::chrono::milliseconds(10);
+    constexpr size_t kRequestTimerSlots = 512;
+}
+
+ThreadSafeZMQDealer::ThreadSafeZMQDealer(zmq::context_t& context, const std::string& address, ZMQReactor* reactor,
+    const SendQueueOptions& queue_options, const SocketOptions& socket_options)
+    : context_(context), address_(address), running_(true), send_queue_(queue_options),
+      reactor_(reactor), reactor_id_(-1), timer_id_(-1), flush_scheduled_(false), received_since_tick_(false),
+      request_timers_(kRequestTimerTick, kRequestTimerSlots), next_correlation_id_(1), request_timer_id_(-1) {
     socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_DEALER);
-    socket_->connect(address_);
-    int timeout_ms = 2000; // 2
+    int timeout_ms = 2000; // 2룬 socket_options 
     socket_->set(zmq::sockopt::sndtimeo, timeout_ms);
     socket_->set(zmq::sockopt::rcvtimeo, timeout_ms);
+    socket_options.apply(*socket_);
+    socket_->connect(address_);
 
     spdlog::info("[Dealer] Connected to {}", address_);
 
-    dealer_thread_ = std::thread(&ThreadSafeZMQDealer::dealer_loop, this);
+    if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short revents) {
+            if (revents & ZMQ_POLLIN) {
+                received_since_tick_ = true;
+                receive_available();
+            }
+            if (revents & ZMQ_POLLOUT)
+                on_reactor_writable();
+            });
+        // ߳ģʽ 2  poll ʱһ£һûյϢͻصʱ
+        timer_id_ = reactor_->add_timer(kReceiveTimeout, [this]() {
+            if (!received_since_tick_ && timeout_callback_)
+                timeout_callback_();
+            received_since_tick_ = false;
+            });
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        dealer_thread_ = std::thread(&ThreadSafeZMQDealer::dealer_loop, this);
+    }
 }
 
 ThreadSafeZMQDealer::~ThreadSafeZMQDealer() {
     running_ = false;
-    cv_.notify_all();
+    send_queue_.close();
+    if (signaler_)
+        signaler_->notify();
+
+    if (reactor_) {
+        int request_timer_id;
+        {
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            request_timer_id = request_timer_id_;
+            request_timer_id_ = -1;
+        }
+        // עremove_timer Ҫ reactor ̣߳ expire_requests е
+        if (request_timer_id >= 0)
+            reactor_->remove_timer(request_timer_id);
+        reactor_->remove_timer(timer_id_);
+        reactor_->remove_socket(reactor_id_);
+    }
 
     if (dealer_thread_.joinable())
         dealer_thread_.join();
 
+    std::unordered_map<uint64_t, ReplyCallback> unfinished;
+    {
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        unfinished.swap(requests_);
+    }
+    for (auto& entry : unfinished) {
+        if (entry.second)
+            entry.second(entry.first, RequestStatus::Cancelled, ByteView());
+    }
+
     socket_->close();
     spdlog::info("[Dealer] Socket closed");
 }
 
-void ThreadSafeZMQDealer::send_async(const std::vector<uint8_t>& data) {
-    std::lock_guard<std::mutex> lock(send_mutex_);
-    if (send_queue_.size() > 1000) {
-        spdlog::warn("[Dealer] Send queue size too large: {}", send_queue_.size());
+bool ThreadSafeZMQDealer::send_async(const std::vector<uint8_t>& data) {
+    return send_async(ZMQMessageUtils::FromBytes(data));
+}
+
+bool ThreadSafeZMQDealer::send_async(std::vector<uint8_t>&& data) {
+    return send_async(ZMQMessageUtils::FromBytes(std::move(data)));
+}
+
+bool ThreadSafeZMQDealer::send_async(zmq::message_t&& msg) {
+    return enqueue(OutgoingMessage{ 0, std::move(msg), SocketMetrics::Clock::now() });
+}
+
+uint64_t ThreadSafeZMQDealer::request_async(zmq::message_t&& msg, ReplyCallback cb, std::chrono::milliseconds timeout) {
+    uint64_t correlation_id = next_correlation_id_.fetch_add(1, std::memory_order_relaxed);
+    {
+        // ȵǼӣظڵǼǵ
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        requests_.emplace(correlation_id, std::move(cb));
+        request_timers_.schedule(correlation_id, timeout);
+
+        // е Dealer ڹ reactor ռڶʱһǼʱעᣬʱպע
+        // add_timer ֻͶ񣬳ò reactor ̻߳
+        if (reactor_ && request_timer_id_ < 0) {
+            request_timer_id_ = reactor_->add_timer(kRequestTimerTick, [this]() {
+                expire_requests();
+                });
+        }
+    }
+
+    if (!enqueue(OutgoingMessage{ correlation_id, std::move(msg), SocketMetrics::Clock::now() })) {
+        // ʱеĿʱ id ѲڣֱӺ
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        requests_.erase(correlation_id);
+        return 0;
     }
-    send_queue_.push(data);
-    cv_.notify_one();
+    return correlation_id;
+}
+
+uint64_t ThreadSafeZMQDealer::request_async(const std::vector<uint8_t>& data, ReplyCallback cb, std::chrono::milliseconds timeout) {
+    return request_async(ZMQMessageUtils::FromBytes(data), std::move(cb), timeout);
+}
+
+std::future<DealerReply> ThreadSafeZMQDealer::request_async(const std::vector<uint8_t>& data, std::chrono::milliseconds timeout) {
+    auto promise = std::make_shared<std::promise<DealerReply>>();
+    std::future<DealerReply> future = promise->get_future();
+
+    uint64_t correlation_id = request_async(data, [promise](uint64_t, RequestStatus status, ByteView reply) {
+        DealerReply result;
+        result.status = status;
+        result.data = reply.to_vector();
+        promise->set_value(std::move(result));
+        }, timeout);
+
+    if (correlation_id == 0) {
+        DealerReply result;
+        result.status = RequestStatus::SendFailed;
+        promise->set_value(std::move(result));
+    }
+    return future;
+}
+
+size_t ThreadSafeZMQDealer::pending_requests() const {
+    std::lock_guard<std::mutex> lock(requests_mutex_);
+    return requests_.size();
+}
+
+bool ThreadSafeZMQDealer::enqueue(OutgoingMessage&& msg) {
+    if (!send_queue_.push(std::move(msg))) {
+        return false;
+    }
+
+    if (signaler_) {
+        signaler_->notify();
+    }
+
+    if (reactor_ && !flush_scheduled_.exchange(true)) {
+        // reactor ̲ܱ߳ sndtimeo  POLLOUT  dontwait 
+        reactor_->set_events(reactor_id_, ZMQ_POLLIN | ZMQ_POLLOUT);
+    }
+    return true;
 }
 
 void ThreadSafeZMQDealer::set_callback(MessageCallback cb) {
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
     message_callback_ = std::move(cb);
 }
 
+void ThreadSafeZMQDealer::set_view_callback(ViewCallback cb) {
+    message_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    view_callback_ = std::move(cb);
+}
+
+void ThreadSafeZMQDealer::set_message_callback(OwnedMessageCallback cb) {
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    owned_callback_ = std::move(cb);
+}
+
+void ThreadSafeZMQDealer::set_batch_end_callback(std::function<void()> callback) {
+    batch_end_callback_ = std::move(callback);
+}
+
 void ThreadSafeZMQDealer::set_timeout_callback(std::function<void()> callback) {
     timeout_callback_ = std::move(callback);
 }
 
 void ThreadSafeZMQDealer::dealer_loop() {
     zmq::pollitem_t items[] = {
-        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 }
+        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 },
+        signaler_->pollitem()
     };
+    auto timeout_deadline = std::chrono::steady_clock::now() + kReceiveTimeout;
 
     while (running_) {
         // 
+        send_queued(zmq::send_flags::none);
+
+        // ݣsend_async ͨ signaler_  poll
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(timeout_deadline - std::chrono::steady_clock::now());
         {
-            std::queue<std::vector<uint8_t>> local_queue;
-            {
-                std::unique_lock<std::mutex> lock(send_mutex_);
-                cv_.wait_for(lock, std::chrono::milliseconds(200), [this] {
-                    return !send_queue_.empty();
-                    });
-                std::swap(send_queue_, local_queue);
-            }
-            // ͷ local_queue еϢ
-            while (!local_queue.empty()) {
-                auto& data = local_queue.front();
-                zmq::message_t msg(data.data(), data.size());
-                auto result = socket_->send(msg, zmq::send_flags::none);
-                if (!result.has_value()) {
-                    spdlog::error("[Dealer] Failed to send message");
-                }
-                else {
-                    spdlog::debug("[Dealer] Sent message size: {}", result.value());
-                }
-                //  result
-                local_queue.pop();
-            }
+            // ;ʱʱֵ tick 鳬ʱ
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            if (!request_timers_.empty())
+                wait = (std::min)(wait, request_timers_.tick());
         }
+        zmq::poll(items, 2, (std::max)(wait, std::chrono::milliseconds(0)));
 
-        // 
-        zmq::poll(items, 1, std::chrono::milliseconds(2000));
-        if (items[0].revents & ZMQ_POLLIN) {
-            std::vector<uint8_t> complete_data;
-
-            while (true) {
-                zmq::message_t msg;
-                auto result = socket_->recv(msg, zmq::recv_flags::none);
-                if (!result.has_value()) {
-                    spdlog::warn("[Dealer] recv returned no message or was interrupted");
-                    break;
-                }
-
-                complete_data.insert(complete_data.end(),
-                    static_cast<uint8_t*>(msg.data()),
-                    static_cast<uint8_t*>(msg.data()) + msg.size());
-
-                bool more = socket_->get(zmq::sockopt::rcvmore);
-                if (!more) 
-                    break;
-            }
-
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
+        }
 
-            spdlog::debug("[Dealer] Received message size: {}", complete_data.size());
-            if (message_callback_) 
-                message_callback_(complete_data);
-        } else {
+        auto now = std::chrono::steady_clock::now();
+        if (items[0].revents & ZMQ_POLLIN) {
+            receive_available();
+            timeout_deadline = now + kReceiveTimeout;
+        } else if (now >= timeout_deadline) {
             // ʱûϢ
             if (timeout_callback_) 
                 timeout_callback_();
+            timeout_deadline = now + kReceiveTimeout;
         }
+
+        expire_requests();
     }
 
     spdlog::debug("[Dealer] Dealer_loop exited");
 }
+
+void ThreadSafeZMQDealer::send_queued(zmq::send_flags flags) {
+    std::deque<OutgoingMessage> local_queue;
+    send_queue_.drain(local_queue);
+    metrics_.observe_queue_depth(local_queue.size());
+
+    // һȡ local_queue еϢ
+    while (!local_queue.empty()) {
+        auto& msg = local_queue.front();
+        if (!send_one(msg, flags)) {
+            metrics_.on_send_failure();
+            spdlog::error("[Dealer] Failed to send message");
+            if (ReplyCallback cb = take_request(msg.correlation_id))
+                cb(msg.correlation_id, RequestStatus::SendFailed, ByteView());
+        }
+        local_queue.pop_front();
+    }
+}
+
+bool ThreadSafeZMQDealer::send_one(OutgoingMessage& msg, zmq::send_flags flags) {
+    zmq::send_result_t result;
+    size_t size = msg.content.size();
+    if (msg.correlation_id != 0) {
+        // ֡Ϣֻ֡ HWM ƣ֡ɹ֡ʧܣ֡ʧʱϢֲ
+        result = socket_->send(ZMQMessageUtils::MakeCorrelationFrame(msg.correlation_id), flags | zmq::send_flags::sndmore);
+        if (result.has_value())
+            result = socket_->send(msg.content, flags);
+    }
+    else {
+        result = socket_->send(msg.content, flags);
+    }
+
+    if (result.has_value()) {
+        metrics_.on_sent(size, msg.enqueued_at);
+        ZMQ_HOT_DEBUG("[Dealer] Sent message size: {}", result.value());
+    }
+    return result.has_value();
+}
+
+void ThreadSafeZMQDealer::send_pending() {
+    while (!pending_.empty() || send_queue_.drain(pending_) > 0) {
+        metrics_.observe_queue_depth(pending_.size());
+        if (!send_one(pending_.front(), zmq::send_flags::dontwait)) {
+            // ԶʱдEAGAINϢȴһ POLLOUT
+            break;
+        }
+        pending_.pop_front();
+    }
+}
+
+void ThreadSafeZMQDealer::on_reactor_writable() {
+    send_pending();
+
+    // ټУ send_async ʱ©ӵ
+    flush_scheduled_ = false;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pending_.empty() && send_queue_.empty()) {
+        reactor_->set_events(reactor_id_, ZMQ_POLLIN);
+    }
+    else {
+        flush_scheduled_ = true;
+    }
+}
+
+void ThreadSafeZMQDealer::receive_available() {
+    // һξ¼ȡѵϢͺͬһ reactor ϵ socket
+    size_t count = 0;
+    while (count < ZMQReactor::kMaxReceiveBatch && receive_message())
+        ++count;
+    if (count > 0 && batch_end_callback_)
+        batch_end_callback_();
+}
+
+bool ThreadSafeZMQDealer::receive_message() {
+    // Router Ļظ [֡][]ǿֻ֡ͨһ֡ʱֱʹø֡ƴ
+    std::vector<zmq::message_t> frames;
+    size_t total_size = 0;
+
+    // ֡ȴûпɶϢʱֱӷأ֡֡ԭӵ
+    zmq::recv_flags flags = zmq::recv_flags::dontwait;
+    while (true) {
+        zmq::message_t msg;
+        auto result = socket_->recv(msg, flags);
+        if (!result.has_value()) {
+            if (flags == zmq::recv_flags::dontwait)
+                return false;
+            ZMQ_HOT_WARN("[Dealer] recv returned no message or was interrupted");
+            break;
+        }
+        flags = zmq::recv_flags::none;
+
+        total_size += msg.size();
+        frames.push_back(std::move(msg));
+
+        bool more = socket_->get(zmq::sockopt::rcvmore);
+        if (!more) 
+            break;
+    }
+
+    // ֡Ļظ[֡][]֡ռͨظ֡λãӦĻصͨص
+    // ֡λú͸жϣͨظ [֡][] ǡ֡ʱҲ
+    uint64_t correlation_id = 0;
+    if (frames.size() == 2 && ZMQMessageUtils::ParseCorrelationFrame(frames[0], correlation_id)) {
+        ReplyCallback cb = take_request(correlation_id);
+        if (!cb) {
+            ZMQ_HOT_DEBUG("[Dealer] Dropped late reply for request {}", correlation_id);
+            return true;
+        }
+        ByteView data(frames[1]);
+        auto callback_start = SocketMetrics::Clock::now();
+        cb(correlation_id, RequestStatus::Ok, data);
+        metrics_.on_received(data.size(), callback_start);
+        return true;
+    }
+
+    frames.erase(std::remove_if(frames.begin(), frames.end(), [](const zmq::message_t& frame) { return frame.size() == 0; }),
+        frames.end());
+
+    zmq::message_t complete_msg;
+    if (frames.size() == 1) {
+        complete_msg = std::move(frames.front());
+    }
+    else if (frames.size() > 1) {
+        complete_msg.rebuild(total_size);
+        uint8_t* out = static_cast<uint8_t*>(complete_msg.data());
+        for (const auto& frame : frames) {
+            std::memcpy(out, frame.data(), frame.size());
+            out += frame.size();
+        }
+    }
+
+    ZMQ_HOT_DEBUG("[Dealer] Received message size: {}", complete_msg.size());
+    size_t size = complete_msg.size();
+    auto callback_start = SocketMetrics::Clock::now();
+    if (owned_callback_) {
+        owned_callback_(std::move(complete_msg));
+    }
+    else if (view_callback_) {
+        view_callback_(ByteView(complete_msg));
+    }
+    else if (message_callback_) {
+        std::vector<uint8_t> complete_data(static_cast<uint8_t*>(complete_msg.data()),
+            static_cast<uint8_t*>(complete_msg.data()) + complete_msg.size());
+        message_callback_(complete_data);
+    }
+    metrics_.on_received(size, callback_start);
+    return true;
+}
+
+ThreadSafeZMQDealer::ReplyCallback ThreadSafeZMQDealer::take_request(uint64_t correlation_id) {
+    ReplyCallback cb;
+    if (correlation_id == 0)
+        return cb;
+
+    std::lock_guard<std::mutex> lock(requests_mutex_);
+    auto it = requests_.find(correlation_id);
+    if (it != requests_.end()) {
+        cb = std::move(it->second);
+        requests_.erase(it);
+    }
+    return cb;
+}
+
+void ThreadSafeZMQDealer::expire_requests() {
+    std::vector<uint64_t> expired;
+    std::vector<std::pair<uint64_t, ReplyCallback>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(requests_mutex_);
+        if (!request_timers_.empty()) {
+            request_timers_.advance(TimerWheel::Clock::now(), expired);
+            for (uint64_t id : expired) {
+                auto it = requests_.find(id);
+                if (it == requests_.end())
+                    continue;  // յظ
+                callbacks.emplace_back(id, std::move(it->second));
+                requests_.erase(it);
+            }
+        }
+        if (request_timers_.empty())
+            disarm_request_timer();
+    }
+
+    // صصпԼ
+    for (auto& entry : callbacks) {
+        metrics_.on_timeout();
+        if (entry.second)
+            entry.second(entry.first, RequestStatus::Timeout, ByteView());
+    }
+}
+
+void ThreadSafeZMQDealer::disarm_request_timer() {
+    // reactor ģʽɶʱ reactor ߳ϵãremove_timer ڱֱִ߳Уȴ
+    if (request_timer_id_ < 0)
+        return;
+    reactor_->remove_timer(request_timer_id_);
+    request_timer_id_ = -1;
+}
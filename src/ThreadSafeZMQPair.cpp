@@ -2,10 +2,17 @@
 #include "LoggerManager.h"
 #include <iostream>
 
-ThreadSafeZMQPair::ThreadSafeZMQPair(zmq::context_t& context, const std::string& address, bool isBind)
-    : context_(context), running_(true), address_(address), isBind_(isBind)
+namespace {
+    constexpr int kMaxSendBatch = 10;  // ֹ޷ռ CPU
+}
+
+ThreadSafeZMQPair::ThreadSafeZMQPair(zmq::context_t& context, const std::string& address, bool isBind, ZMQReactor* reactor,
+    const SendQueueOptions& queue_options, const SocketOptions& socket_options)
+    : context_(context), running_(true), address_(address), isBind_(isBind), send_queue_(queue_options),
+      reactor_(reactor), reactor_id_(-1), flush_scheduled_(false)
 {
     socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_PAIR);
+    socket_options.apply(*socket_);
     if (isBind) {
         socket_->bind(address);
         spdlog::info("[PAIR] Bound to: {}", address);
@@ -15,13 +22,24 @@ ThreadSafeZMQPair::ThreadSafeZMQPair(zmq::context_t& context, const std::string&
         spdlog::info("[PAIR] Connected to: {}", address);
     }
 
-    io_thread_ = std::thread(&ThreadSafeZMQPair::io_loop, this);
+    if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short revents) { on_reactor_events(revents); });
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        io_thread_ = std::thread(&ThreadSafeZMQPair::io_loop, this);
+    }
 }
 
 ThreadSafeZMQPair::~ThreadSafeZMQPair()
 {
     running_ = false;
-    cv_.notify_all();
+    send_queue_.close();
+    if (signaler_)
+        signaler_->notify();
+
+    if (reactor_)
+        reactor_->remove_socket(reactor_id_);
 
     if (io_thread_.joinable())
         io_thread_.join();
@@ -32,61 +50,161 @@ ThreadSafeZMQPair::~ThreadSafeZMQPair()
     }
 }
 
-void ThreadSafeZMQPair::send_async(const std::vector<uint8_t>& data)
+bool ThreadSafeZMQPair::send_async(const std::vector<uint8_t>& data)
+{
+    return send_async(ZMQMessageUtils::FromBytes(data));
+}
+
+bool ThreadSafeZMQPair::send_async(std::vector<uint8_t>&& data)
 {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    send_queue_.emplace(data);
-    cv_.notify_one();
+    return send_async(ZMQMessageUtils::FromBytes(std::move(data)));
+}
+
+bool ThreadSafeZMQPair::send_async(zmq::message_t&& msg)
+{
+    if (!send_queue_.push(OutgoingMessage{ std::move(msg), SocketMetrics::Clock::now() })) {
+        return false;
+    }
+
+    if (signaler_) {
+        signaler_->notify();
+    }
+
+    // reactor ģʽݴʱŹע POLLOUT
+    if (reactor_ && !flush_scheduled_.exchange(true)) {
+        reactor_->set_events(reactor_id_, ZMQ_POLLIN | ZMQ_POLLOUT);
+    }
+    return true;
 }
 
 void ThreadSafeZMQPair::set_callback(MessageCallback callback)
 {
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
     message_callback_ = std::move(callback);
 }
 
+void ThreadSafeZMQPair::set_view_callback(ViewCallback callback)
+{
+    message_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    view_callback_ = std::move(callback);
+}
+
+void ThreadSafeZMQPair::set_message_callback(OwnedMessageCallback callback)
+{
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    owned_callback_ = std::move(callback);
+}
+
+void ThreadSafeZMQPair::set_batch_end_callback(std::function<void()> callback)
+{
+    batch_end_callback_ = std::move(callback);
+}
+
 void ThreadSafeZMQPair::io_loop()
 {
     zmq::pollitem_t items[] = {
-        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN | ZMQ_POLLOUT, 0 }
+        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 },
+        signaler_->pollitem()
     };
 
     while (running_) {
-        zmq::poll(items, 1, std::chrono::milliseconds(200));
+        // ֻжʱŹע POLLOUT socket һֱд poll ת
+        items[0].events = send_queue_.empty() ? ZMQ_POLLIN : (ZMQ_POLLIN | ZMQ_POLLOUT);
+        zmq::poll(items, 2, std::chrono::milliseconds(200));
+
+        // send_async Ļźţȡߺһֻ¼ POLLOUT
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
+        }
 
         // === 1. Receive if data available
         if (items[0].revents & ZMQ_POLLIN) {
-            zmq::message_t body;
-            if (socket_->recv(body, zmq::recv_flags::none)) {
-                if (message_callback_) {
-                    std::vector<uint8_t> data(static_cast<uint8_t*>(body.data()),
-                        static_cast<uint8_t*>(body.data()) + body.size());
-                    message_callback_(data);
-                    spdlog::info("[PAIR] Received binary size: {}", body.size());
-                }
-            }
+            receive_available();
         }
 
         // === 2. Send if socket is writable
         if (items[0].revents & ZMQ_POLLOUT) {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            int send_count = 0;
-            const int max_batch = 10;  // ֹ޷ռ CPU
-
-            while (!send_queue_.empty() && send_count++ < max_batch) {
-                std::vector<uint8_t> data = std::move(send_queue_.front());
-                send_queue_.pop();
-                lock.unlock();
-
-                zmq::message_t body(data.data(), data.size());
-                auto result = socket_->send(body, zmq::send_flags::dontwait);
-                if (!result.has_value()) {
-                    spdlog::warn("[PAIR] Send failed.");
-                }
-
-                lock.lock();
-            }
+            send_queued(kMaxSendBatch);
         }
     }
 
     spdlog::debug("[PAIR] Exit io_loop");
 }
+
+void ThreadSafeZMQPair::on_reactor_events(short revents)
+{
+    if (revents & ZMQ_POLLIN) {
+        receive_available();
+    }
+
+    if (revents & ZMQ_POLLOUT) {
+        send_queued(kMaxSendBatch);
+
+        // ټУ send_async ʱ©ӵ
+        flush_scheduled_ = false;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (send_queue_.empty()) {
+            reactor_->set_events(reactor_id_, ZMQ_POLLIN);
+        }
+        else {
+            flush_scheduled_ = true;
+        }
+    }
+}
+
+void ThreadSafeZMQPair::receive_available()
+{
+    // һξ¼ȡѵϢͺͬһ reactor ϵ socket
+    size_t count = 0;
+    while (count < ZMQReactor::kMaxReceiveBatch && receive_one())
+        ++count;
+    if (count > 0 && batch_end_callback_)
+        batch_end_callback_();
+}
+
+bool ThreadSafeZMQPair::receive_one()
+{
+    zmq::message_t body;
+    if (!socket_->recv(body, zmq::recv_flags::dontwait))
+        return false;
+
+    size_t size = body.size();
+    auto callback_start = SocketMetrics::Clock::now();
+    if (owned_callback_) {
+        owned_callback_(std::move(body));
+    }
+    else if (view_callback_) {
+        view_callback_(ByteView(body));
+    }
+    else if (message_callback_) {
+        std::vector<uint8_t> data(static_cast<uint8_t*>(body.data()),
+            static_cast<uint8_t*>(body.data()) + body.size());
+        message_callback_(data);
+    }
+    metrics_.on_received(size, callback_start);
+    ZMQ_HOT_INFO("[PAIR] Received binary size: {}", size);
+    return true;
+}
+
+void ThreadSafeZMQPair::send_queued(int max_batch)
+{
+    std::deque<OutgoingMessage> batch;
+    size_t depth = send_queue_.size();
+    send_queue_.drain(batch, max_batch);
+    metrics_.observe_queue_depth(depth);
+
+    for (auto& msg : batch) {
+        size_t size = msg.content.size();
+        auto result = socket_->send(msg.content, zmq::send_flags::dontwait);
+        if (!result.has_value()) {
+            metrics_.on_send_failure();
+            ZMQ_HOT_WARN("[PAIR] Send failed.");
+        }
+        else {
+            metrics_.on_sent(size, msg.enqueued_at);
+        }
+    }
+}
@@ -2,10 +2,18 @@
 #include <iostream>
 #include "LoggerManager.h"
 
-ThreadSafeZMQPublisher::ThreadSafeZMQPublisher(zmq::context_t& context, const std::string& address, bool isBind)
-    : context_(context), running_(true), address_(address), isBind_(isBind)
+ThreadSafeZMQPublisher::ThreadSafeZMQPublisher(zmq::context_t& context, const std::string& address, bool isBind, ZMQReactor* reactor,
+    const SendQueueOptions& queue_options, const SocketOptions& socket_options, const PublisherOptions& publisher_options)
+    : context_(context), running_(true), address_(address), isBind_(isBind), send_queue_(queue_options),
+      reactor_(reactor), reactor_id_(-1), snapshot_reactor_id_(-1), flush_scheduled_(false)
 {
+    if (publisher_options.conflate)
+        conflating_queue_ = std::make_unique<ConflatingQueue<OutgoingMessage>>();
+    if (publisher_options.last_value_cache || !publisher_options.snapshot_address.empty())
+        last_values_ = std::make_unique<LastValueCache>();
+
     socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_PUB);
+    socket_options.apply(*socket_);
     if (isBind_) {
         socket_->bind(address_);
         spdlog::info("[Publisher] Bound to {}", address_);
@@ -15,56 +23,256 @@ ThreadSafeZMQPublisher::ThreadSafeZMQPublisher(zmq::context_t& context, const st
         spdlog::info("[Publisher] Connected to {}", address_);
     }
 
-    publisher_thread_ = std::thread(&ThreadSafeZMQPublisher::publisher_loop, this);
+    if (!publisher_options.snapshot_address.empty()) {
+        snapshot_socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_ROUTER);
+        snapshot_socket_->set(zmq::sockopt::linger, 0);
+        snapshot_socket_->bind(publisher_options.snapshot_address);
+        spdlog::info("[Publisher] Snapshot service bound to {}", publisher_options.snapshot_address);
+        if (publisher_options.retransmit_depth > 0)
+            retransmit_ = std::make_unique<RetransmitBuffer>(publisher_options.retransmit_depth);
+    }
+    else if (publisher_options.retransmit_depth > 0) {
+        spdlog::warn("[Publisher] retransmit_depth ignored without a snapshot_address");
+    }
+
+    if (reactor_) {
+        // PUB Ҫ¼ݴʱŹע POLLOUT publish_async
+        reactor_id_ = reactor_->add_socket(*socket_, 0, [this](short) { on_reactor_writable(); });
+        if (snapshot_socket_)
+            snapshot_reactor_id_ = reactor_->add_socket(*snapshot_socket_, ZMQ_POLLIN, [this](short) { serve_requests(); });
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        publisher_thread_ = std::thread(&ThreadSafeZMQPublisher::publisher_loop, this);
+    }
 }
 
 ThreadSafeZMQPublisher::~ThreadSafeZMQPublisher()
 {
     running_ = false;
-    cv_.notify_all();
+    send_queue_.close();
+    if (signaler_)
+        signaler_->notify();
+    if (reactor_) {
+        if (snapshot_socket_)
+            reactor_->remove_socket(snapshot_reactor_id_);
+        reactor_->remove_socket(reactor_id_);
+    }
     if (publisher_thread_.joinable())
         publisher_thread_.join();
 
+    if (snapshot_socket_)
+        snapshot_socket_->close();
     if (socket_) {
         socket_->close();
         spdlog::info("[Publisher] Socket closed");
     }
 }
 
-void ThreadSafeZMQPublisher::publish_async(const std::string& topic, const std::vector<uint8_t>& data)
+bool ThreadSafeZMQPublisher::publish_async(const std::string& topic, const std::vector<uint8_t>& data)
 {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    send_queue_.push({ topic, data });
-    cv_.notify_one();
+    return publish_async(topic, ZMQMessageUtils::FromBytes(data));
+}
+
+bool ThreadSafeZMQPublisher::publish_async(const std::string& topic, std::vector<uint8_t>&& data)
+{
+    return publish_async(topic, ZMQMessageUtils::FromBytes(std::move(data)));
+}
+
+bool ThreadSafeZMQPublisher::publish_async(const std::string& topic, zmq::message_t&& msg)
+{
+    if (conflating_queue_) {
+        conflating_queue_->push({ topic, std::move(msg), SocketMetrics::Clock::now() });
+    }
+    else if (!send_queue_.push({ topic, std::move(msg), SocketMetrics::Clock::now() })) {
+        return false;
+    }
+
+    if (signaler_) {
+        signaler_->notify();
+    }
+
+    if (reactor_ && !flush_scheduled_.exchange(true)) {
+        reactor_->set_events(reactor_id_, ZMQ_POLLOUT);
+    }
+    return true;
+}
+
+SendQueueStats ThreadSafeZMQPublisher::queue_stats() const
+{
+    if (!conflating_queue_)
+        return send_queue_.stats();
+
+    SendQueueStats stats;
+    stats.queued = conflating_queue_->size();
+    stats.replaced = conflating_queue_->replaced();
+    return stats;
+}
+
+bool ThreadSafeZMQPublisher::last_value(const std::string& topic, zmq::message_t& out) const
+{
+    return last_values_ && last_values_->get(topic, out);
+}
+
+size_t ThreadSafeZMQPublisher::drain_queue()
+{
+    return conflating_queue_ ? conflating_queue_->drain(pending_) : send_queue_.drain(pending_);
+}
+
+bool ThreadSafeZMQPublisher::queue_empty() const
+{
+    return conflating_queue_ ? conflating_queue_->empty() : send_queue_.empty();
 }
 
 void ThreadSafeZMQPublisher::publisher_loop()
 {
+    zmq::pollitem_t items[] = {
+        { static_cast<void*>(*socket_), 0, 0, 0 },
+        signaler_->pollitem(),
+        { snapshot_socket_ ? static_cast<void*>(*snapshot_socket_) : nullptr, 0, ZMQ_POLLIN, 0 }
+    };
+    int item_count = snapshot_socket_ ? 3 : 2;
+
     while (running_) {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        cv_.wait(lock, [this]() { return !send_queue_.empty() || !running_; });
+        // лѹʱŹע POLLOUTһοд¼Ϣ EAGAIN Ϊֹ
+        items[0].events = pending_.empty() ? 0 : ZMQ_POLLOUT;
+        zmq::poll(items, item_count, std::chrono::milliseconds(200));
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
+        }
+        // ȷȡϢٻظգŲѾϢ
+        send_pending();
+        if (snapshot_socket_ && (items[2].revents & ZMQ_POLLIN)) {
+            serve_requests();
+        }
+    }
 
-        while (!send_queue_.empty()) {
-            auto item = std::move(send_queue_.front());
-            send_queue_.pop();
-            lock.unlock();
+    spdlog::debug("[Publisher] publisher_loop exited");
+}
 
-            zmq::message_t topic_msg(item.topic.data(), item.topic.size());
-            socket_->send(topic_msg, zmq::send_flags::sndmore);
+void ThreadSafeZMQPublisher::send_pending()
+{
+    // һȡpending_ ֮ǰٴӶȡ
+    // ϲģʽ»ѹڼϢںϲ滻ֻ pending_ ȡһ
+    while (!pending_.empty() || drain_queue() > 0) {
+        OutgoingMessage& item = pending_.front();
+        metrics_.observe_queue_depth(pending_.size());
 
-            zmq::message_t body_msg(item.content.data(), item.content.size());
-            auto res = socket_->send(body_msg, zmq::send_flags::none);
+        // ֡Ϣֻڵһ֡ HWMtopic ֡Ϣһ
+        zmq::message_t topic_msg(item.topic.data(), item.topic.size());
+        if (!socket_->send(topic_msg, zmq::send_flags::sndmore | zmq::send_flags::dontwait).has_value()) {
+            break;
+        }
 
-            if (!res.has_value()) {
-                spdlog::warn("[Publisher] Send failed");
-            }
-            else {
-                spdlog::info("[Publisher] Sent topic: {}, size: {}", item.topic.data(), item.content.size());
-            }
+        // ֵڽ socket ʱ¼붩ĶʵյϢһ£ϲϢռ
+        uint64_t sequence = last_values_ ? last_values_->update(item.topic, item.content) : 0;
+        bool sequenced = snapshot_socket_ != nullptr;
+        if (retransmit_)
+            retransmit_->store(item.topic, sequence, item.content);
 
-            lock.lock();
+        auto res = socket_->send(item.content, sequenced ? (zmq::send_flags::sndmore | zmq::send_flags::dontwait) : zmq::send_flags::dontwait);
+        if (res.has_value() && sequenced) {
+            socket_->send(ZMQMessageUtils::MakeSequenceFrame(sequence), zmq::send_flags::dontwait);
+        }
+        if (!res.has_value()) {
+            metrics_.on_send_failure();
+            ZMQ_HOT_WARN("[Publisher] Send failed");
         }
+        else {
+            metrics_.on_sent(item.topic.size() + res.value(), item.enqueued_at);
+            ZMQ_HOT_INFO("[Publisher] Sent topic: {}, size: {}", item.topic.data(), res.value());
+        }
+        pending_.pop_front();
     }
+}
 
-    spdlog::debug("[Publisher] publisher_loop exited");
+void ThreadSafeZMQPublisher::serve_requests()
+{
+    // Ϊ [identity][][...]ʽ ZMQMessageUtils::kSnapshotTag
+    for (;;) {
+        zmq::message_t identity;
+        if (!snapshot_socket_->recv(identity, zmq::recv_flags::dontwait))
+            return;
+
+        std::vector<zmq::message_t> frames;
+        while (snapshot_socket_->get(zmq::sockopt::rcvmore)) {
+            zmq::message_t frame;
+            if (!snapshot_socket_->recv(frame, zmq::recv_flags::none))
+                break;
+            frames.push_back(std::move(frame));
+        }
+
+        uint8_t tag = frames.empty() || frames[0].size() != 1 ? 0 : *static_cast<const uint8_t*>(frames[0].data());
+        if (tag == ZMQMessageUtils::kSnapshotTag && frames.size() == 2) {
+            serve_snapshot(identity, frames[1]);
+        }
+        else if (tag == ZMQMessageUtils::kRetransmitTag && frames.size() == 4) {
+            serve_retransmit(identity, frames);
+        }
+        else {
+            spdlog::warn("[Publisher] Ignored malformed request with {} frames", frames.size());
+        }
+    }
+}
+
+void ThreadSafeZMQPublisher::serve_snapshot(zmq::message_t& identity, const zmq::message_t& prefix)
+{
+    // ظΪһ֡Ϣֻռһ HWM ҪôʹҪô
+    std::vector<LastValueCache::Entry> entries = last_values_->snapshot(
+        std::string_view(static_cast<const char*>(prefix.data()), prefix.size()));
+
+    uint8_t tag = ZMQMessageUtils::kSnapshotTag;
+    snapshot_socket_->send(identity, zmq::send_flags::sndmore);
+    snapshot_socket_->send(zmq::message_t(&tag, sizeof(tag)), entries.empty() ? zmq::send_flags::none : zmq::send_flags::sndmore);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        LastValueCache::Entry& entry = entries[i];
+        snapshot_socket_->send(zmq::message_t(entry.topic.data(), entry.topic.size()), zmq::send_flags::sndmore);
+        snapshot_socket_->send(ZMQMessageUtils::MakeSequenceFrame(entry.sequence), zmq::send_flags::sndmore);
+        snapshot_socket_->send(entry.value, i + 1 < entries.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
+    }
+
+    spdlog::info("[Publisher] Served snapshot of {} topics for prefix '{}'", entries.size(), prefix.to_string_view());
+}
+
+void ThreadSafeZMQPublisher::serve_retransmit(zmq::message_t& identity, const std::vector<zmq::message_t>& frames)
+{
+    // frames Ϊ [][topic][ʼ][]ûòϢѱʱֻظͷĶ˰ȱĲּΪʧ
+    uint64_t from = 0;
+    uint64_t to = 0;
+    if (!ZMQMessageUtils::ParseSequenceFrame(frames[2], from) || !ZMQMessageUtils::ParseSequenceFrame(frames[3], to)) {
+        spdlog::warn("[Publisher] Ignored malformed retransmit request");
+        return;
+    }
+
+    std::string topic = frames[1].to_string();
+    std::vector<RetransmitBuffer::Entry> entries;
+    if (retransmit_)
+        retransmit_->collect(topic, from, to, entries);
+
+    uint8_t tag = ZMQMessageUtils::kRetransmitTag;
+    snapshot_socket_->send(identity, zmq::send_flags::sndmore);
+    snapshot_socket_->send(zmq::message_t(&tag, sizeof(tag)), zmq::send_flags::sndmore);
+    snapshot_socket_->send(zmq::message_t(topic.data(), topic.size()), zmq::send_flags::sndmore);
+    snapshot_socket_->send(ZMQMessageUtils::MakeSequenceFrame(to), entries.empty() ? zmq::send_flags::none : zmq::send_flags::sndmore);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        snapshot_socket_->send(ZMQMessageUtils::MakeSequenceFrame(entries[i].sequence), zmq::send_flags::sndmore);
+        snapshot_socket_->send(entries[i].value, i + 1 < entries.size() ? zmq::send_flags::sndmore : zmq::send_flags::none);
+    }
+
+    ZMQ_HOT_INFO("[Publisher] Retransmitted {} of {} messages for topic {}", entries.size(), to - from + 1, topic);
+}
+
+void ThreadSafeZMQPublisher::on_reactor_writable()
+{
+    send_pending();
+
+    // ټУ publish_async ʱ©ӵ
+    flush_scheduled_ = false;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pending_.empty() && queue_empty()) {
+        reactor_->set_events(reactor_id_, 0);
+    }
+    else {
+        flush_scheduled_ = true;
+    }
 }
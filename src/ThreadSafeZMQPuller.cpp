@@ -2,20 +2,28 @@
 #include <iostream>
 #include "LoggerManager.h"
 
-ThreadSafeZMQPuller::ThreadSafeZMQPuller(zmq::context_t& context, const std::string& address, bool isBind)
-    : context_(context), running_(true), address_(address), isBind_(isBind)
+ThreadSafeZMQPuller::ThreadSafeZMQPuller(zmq::context_t& context, const std::string& address, bool isBind, ZMQReactor* reactor,
+    const SocketOptions& socket_options)
+    : context_(context), running_(true), address_(address), isBind_(isBind), reactor_(reactor), reactor_id_(-1)
 {
     if (isBind) {
         socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_PUSH);
+        socket_options.apply(*socket_);
         socket_->bind(address);
         spdlog::info("[Puller] Socket bound to: {}", address);
     }
     else {
         spdlog::info("[Puller] Socket connected to: {}", address);
         socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_PULL);
+        socket_options.apply(*socket_);
         socket_->connect(address);
     }
-    receiver_thread_ = std::thread(&ThreadSafeZMQPuller::puller_loop, this);
+    if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short) { receive_available(); });
+    }
+    else {
+        receiver_thread_ = std::thread(&ThreadSafeZMQPuller::puller_loop, this);
+    }
 
     spdlog::debug("[Puller] Constructed");
 }
@@ -24,6 +32,9 @@ ThreadSafeZMQPuller::~ThreadSafeZMQPuller()
 {
     running_ = false;
 
+    if (reactor_)
+        reactor_->remove_socket(reactor_id_);
+
     if (receiver_thread_.joinable())
         receiver_thread_.join();    // ȴ߳˳
 
@@ -37,9 +48,30 @@ ThreadSafeZMQPuller::~ThreadSafeZMQPuller()
 
 void ThreadSafeZMQPuller::set_callback(MessageCallback callback)
 {
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
     message_callback_ = std::move(callback);
 }
 
+void ThreadSafeZMQPuller::set_view_callback(ViewCallback callback)
+{
+    message_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    view_callback_ = std::move(callback);
+}
+
+void ThreadSafeZMQPuller::set_message_callback(OwnedMessageCallback callback)
+{
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    owned_callback_ = std::move(callback);
+}
+
+void ThreadSafeZMQPuller::set_batch_end_callback(std::function<void()> callback)
+{
+    batch_end_callback_ = std::move(callback);
+}
+
 void ThreadSafeZMQPuller::puller_loop()
 {
     while (running_) {
@@ -49,19 +81,42 @@ void ThreadSafeZMQPuller::puller_loop()
         zmq::poll(items, 1, std::chrono::milliseconds(200));
 
         if (items[0].revents & ZMQ_POLLIN) {
-            zmq::message_t msg;
-            if (socket_->recv(msg, zmq::recv_flags::dontwait)) {
-                std::vector<uint8_t> data(static_cast<uint8_t*>(msg.data()),
-                    static_cast<uint8_t*>(msg.data()) + msg.size());
-                if (message_callback_) {
-                    message_callback_(data);
-                }
-                spdlog::info("[Puller] Received data size: {}", msg.size());
-            }
-            else {
-                spdlog::warn("[Puller] Receive failed.");
-            }
+            receive_available();
         }
     }
     spdlog::debug("[Puller] exit receiver_loop");
 }
+
+void ThreadSafeZMQPuller::receive_available()
+{
+    // һξ¼ȡѵϢͬһ reactor ϵ socket
+    size_t count = 0;
+    while (count < ZMQReactor::kMaxReceiveBatch && receive_one())
+        ++count;
+    if (count > 0 && batch_end_callback_)
+        batch_end_callback_();
+}
+
+bool ThreadSafeZMQPuller::receive_one()
+{
+    zmq::message_t msg;
+    if (!socket_->recv(msg, zmq::recv_flags::dontwait))
+        return false;
+
+    size_t size = msg.size();
+    auto callback_start = SocketMetrics::Clock::now();
+    if (owned_callback_) {
+        owned_callback_(std::move(msg));
+    }
+    else if (view_callback_) {
+        view_callback_(ByteView(msg));
+    }
+    else if (message_callback_) {
+        std::vector<uint8_t> data(static_cast<uint8_t*>(msg.data()),
+            static_cast<uint8_t*>(msg.data()) + msg.size());
+        message_callback_(data);
+    }
+    metrics_.on_received(size, callback_start);
+    ZMQ_HOT_INFO("[Puller] Received data size: {}", size);
+    return true;
+}
@@ -2,20 +2,31 @@
 #include <iostream>
 #include "LoggerManager.h"
 
-ThreadSafeZMQPusher::ThreadSafeZMQPusher(zmq::context_t& context, const std::string& address, bool isBind)
-    : context_(context), running_(true), address_(address), isBind_(isBind)
+ThreadSafeZMQPusher::ThreadSafeZMQPusher(zmq::context_t& context, const std::string& address, bool isBind, ZMQReactor* reactor,
+    const SendQueueOptions& queue_options, const SocketOptions& socket_options)
+    : context_(context), message_queue_(queue_options), running_(true), address_(address), isBind_(isBind),
+      reactor_(reactor), reactor_id_(-1), flush_scheduled_(false)
 {
     if (isBind) {
         socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_PUSH);
+        socket_options.apply(*socket_);
         socket_->bind(address);
         spdlog::info("[Pusher] Socket bound to: {}", address);
     }
     else {
         socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_PULL);
+        socket_options.apply(*socket_);
         socket_->connect(address);
         spdlog::info("[Pusher] Socket connected to: {}", address);
     }
-    sender_thread_ = std::thread(&ThreadSafeZMQPusher::pusher_loop, this);
+    if (reactor_) {
+        // ݴʱŹע POLLOUT send_async
+        reactor_id_ = reactor_->add_socket(*socket_, 0, [this](short) { on_reactor_writable(); });
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        sender_thread_ = std::thread(&ThreadSafeZMQPusher::pusher_loop, this);
+    }
 
     spdlog::debug("[Pusher] Constructed");
 }
@@ -23,7 +34,12 @@ ThreadSafeZMQPusher::ThreadSafeZMQPusher(zmq::context_t& context, const std::str
 ThreadSafeZMQPusher::~ThreadSafeZMQPusher()
 {
     running_ = false;
-    cv_.notify_all();
+    message_queue_.close();
+    if (signaler_)
+        signaler_->notify();
+
+    if (reactor_)
+        reactor_->remove_socket(reactor_id_);
 
     if (sender_thread_.joinable())
         sender_thread_.join();  // ȴ߳˳
@@ -36,48 +52,81 @@ ThreadSafeZMQPusher::~ThreadSafeZMQPusher()
     spdlog::debug("[Pusher] Destructed");
 }
 
-void ThreadSafeZMQPusher::send_async(const std::vector<uint8_t>& data)
+bool ThreadSafeZMQPusher::send_async(const std::vector<uint8_t>& data)
 {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    message_queue_.emplace(data);
-    cv_.notify_one();
+    return send_async(ZMQMessageUtils::FromBytes(data));
+}
+
+bool ThreadSafeZMQPusher::send_async(std::vector<uint8_t>&& data)
+{
+    return send_async(ZMQMessageUtils::FromBytes(std::move(data)));
+}
+
+bool ThreadSafeZMQPusher::send_async(zmq::message_t&& msg)
+{
+    if (!message_queue_.push(OutgoingMessage{ std::move(msg), SocketMetrics::Clock::now() })) {
+        return false;
+    }
+
+    if (signaler_) {
+        signaler_->notify();
+    }
+
+    if (reactor_ && !flush_scheduled_.exchange(true)) {
+        reactor_->set_events(reactor_id_, ZMQ_POLLOUT);
+    }
+    return true;
 }
 
 void ThreadSafeZMQPusher::pusher_loop()
 {
+    zmq::pollitem_t items[] = {
+        { static_cast<void*>(*socket_), 0, 0, 0 },
+        signaler_->pollitem()
+    };
+
     while (running_) {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        cv_.wait(lock, [this]() {
-            return !message_queue_.empty() || !running_;
-        });
-
-        while (!message_queue_.empty()) {
-            std::vector<uint8_t> data = std::move(message_queue_.front());
-            message_queue_.pop();
-            lock.unlock();
-
-            zmq::pollitem_t items[] = {
-                { static_cast<void*>(*socket_), 0, ZMQ_POLLOUT, 0 }
-            };
-            zmq::poll(items, 1, std::chrono::milliseconds(200));
-
-            if (items[0].revents & ZMQ_POLLOUT) {
-                zmq::message_t msg(data.data(), data.size());
-                auto result = socket_->send(msg, zmq::send_flags::dontwait);
-                if (!result.has_value()) {
-                    spdlog::warn("[Pusher] Send failed.");
-                }
-                else {
-                    spdlog::info("[Pusher] Sent data size: {}", data.size());
-                }
-            }
-            else {
-                spdlog::warn("[Pusher] Socket not ready to send.");
-            }
-
-            lock.lock();
+        // лѹʱŹע POLLOUTһοд¼Ϣ EAGAIN Ϊֹ
+        items[0].events = pending_.empty() ? 0 : ZMQ_POLLOUT;
+        zmq::poll(items, 2, std::chrono::milliseconds(200));
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
         }
 
+        send_pending();
     }
     spdlog::debug("[Pusher] exit sender_loop");
 }
+
+void ThreadSafeZMQPusher::send_pending()
+{
+    // pending_ ֮ǰٴӶȡ֤ѹֻнķͶ
+    while (!pending_.empty() || message_queue_.drain(pending_) > 0) {
+        metrics_.observe_queue_depth(pending_.size());
+
+        // ʧʱ libzmq ĶϢԭ pending_ 
+        auto result = socket_->send(pending_.front().content, zmq::send_flags::dontwait);
+        if (!result.has_value()) {
+            // ԶʱдEAGAINϢȴһ POLLOUT
+            break;
+        }
+        metrics_.on_sent(result.value(), pending_.front().enqueued_at);
+        ZMQ_HOT_INFO("[Pusher] Sent data size: {}", result.value());
+        pending_.pop_front();
+    }
+}
+
+void ThreadSafeZMQPusher::on_reactor_writable()
+{
+    send_pending();
+
+    // ټУ send_async ʱ©ӵ
+    flush_scheduled_ = false;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (pending_.empty() && message_queue_.empty()) {
+        reactor_->set_events(reactor_id_, 0);
+    }
+    else {
+        flush_scheduled_ = true;
+    }
+}
@@ -3,14 +3,22 @@
 #include <iostream>
 #include <chrono>
 
-ThreadSafeZMQReplier::ThreadSafeZMQReplier(zmq::context_t& context, const std::string& address)
-    : context_(context), address_(address), running_(true)
+ThreadSafeZMQReplier::ThreadSafeZMQReplier(zmq::context_t& context, const std::string& address, ZMQReactor* reactor,
+    const SocketOptions& socket_options)
+    : context_(context), address_(address), running_(true), reactor_(reactor), reactor_id_(-1)
 {
     socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_REP);
+    socket_options.apply(*socket_);
     socket_->bind(address_);
     spdlog::info("[Replier] Bound to {}", address_);
 
-    replier_thread_ = std::thread(&ThreadSafeZMQReplier::replier_loop, this);
+    if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short) { receive_one(); });
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        replier_thread_ = std::thread(&ThreadSafeZMQReplier::replier_loop, this);
+    }
 }
 
 ThreadSafeZMQReplier::~ThreadSafeZMQReplier()
@@ -18,6 +26,11 @@ ThreadSafeZMQReplier::~ThreadSafeZMQReplier()
     spdlog::debug("[Replier] Destruct called");
 
     running_ = false;
+    send_queue_.close();
+    if (signaler_)
+        signaler_->notify();
+    if (reactor_)
+        reactor_->remove_socket(reactor_id_);
     if (replier_thread_.joinable())
         replier_thread_.join();
 
@@ -29,42 +42,110 @@ ThreadSafeZMQReplier::~ThreadSafeZMQReplier()
 
 void ThreadSafeZMQReplier::set_callback(MessageCallback cb)
 {
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
     message_callback_ = std::move(cb);
     spdlog::debug("[Replier] Callback set");
 }
 
+void ThreadSafeZMQReplier::set_view_callback(ViewCallback cb)
+{
+    message_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    view_callback_ = std::move(cb);
+    spdlog::debug("[Replier] View callback set");
+}
+
+void ThreadSafeZMQReplier::set_message_callback(OwnedMessageCallback cb)
+{
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    owned_callback_ = std::move(cb);
+    spdlog::debug("[Replier] Message callback set");
+}
+
 void ThreadSafeZMQReplier::send_reply(const std::vector<uint8_t>& reply)
 {
-    std::lock_guard<std::mutex> lock(send_mutex_);
+    // socket ֻ I/O ߳ʹãreactor ģʽͶݵ reactor ̣߳߳ģʽ replier_loop
+    if (!reactor_) {
+        if (!send_queue_.push(reply)) {
+            metrics_.on_send_failure();
+            return;
+        }
+        signaler_->notify();
+        return;
+    }
+    if (!reactor_->in_reactor_thread()) {
+        reactor_->post([this, reply]() { send_now(reply); });
+        return;
+    }
+    send_now(reply);
+}
+
+void ThreadSafeZMQReplier::send_queued()
+{
+    std::deque<std::vector<uint8_t>> local_queue;
+    send_queue_.drain(local_queue);
+    for (const auto& reply : local_queue)
+        send_now(reply);
+}
+
+void ThreadSafeZMQReplier::send_now(const std::vector<uint8_t>& reply)
+{
     zmq::message_t msg(reply.data(), reply.size());
-    socket_->send(msg, zmq::send_flags::none);
-    spdlog::info("[Replier] Sent response size: {}", reply.size());
+    if (socket_->send(msg, zmq::send_flags::none).has_value())
+        metrics_.on_sent(reply.size());
+    else
+        metrics_.on_send_failure();
+    ZMQ_HOT_INFO("[Replier] Sent response size: {}", reply.size());
 }
 
 void ThreadSafeZMQReplier::replier_loop()
 {
     zmq::pollitem_t items[] = {
-        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 }
+        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 },
+        signaler_->pollitem()
     };
 
     while (running_) {
-        zmq::poll(items, 1, std::chrono::milliseconds(200));
+        zmq::poll(items, 2, std::chrono::milliseconds(200));
+
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
+        }
 
         if (items[0].revents & ZMQ_POLLIN) {
-            spdlog::debug("[Replier] Waiting msg...");
-            zmq::message_t msg;
-            if (!socket_->recv(msg, zmq::recv_flags::none)) {
-                spdlog::warn("[Replier] Incomplete request received");
-                continue;
-            }
-
-            std::vector<uint8_t> data(static_cast<uint8_t*>(msg.data()), static_cast<uint8_t*>(msg.data()) + msg.size());
-            spdlog::info("[Replier] Received data size: {}", data.size());
-            if (message_callback_) {
-                message_callback_(data);
-            }
+            receive_one();
         }
+
+        // REP ظ֮ǰпɶ
+        send_queued();
     }
 
     spdlog::debug("[Replier] Replier_loop exited");
 }
+
+void ThreadSafeZMQReplier::receive_one()
+{
+    ZMQ_HOT_DEBUG("[Replier] Waiting msg...");
+    zmq::message_t msg;
+    if (!socket_->recv(msg, zmq::recv_flags::dontwait)) {
+        ZMQ_HOT_WARN("[Replier] Incomplete request received");
+        return;
+    }
+
+    ZMQ_HOT_INFO("[Replier] Received data size: {}", msg.size());
+    size_t size = msg.size();
+    auto callback_start = SocketMetrics::Clock::now();
+    if (owned_callback_) {
+        owned_callback_(std::move(msg));
+    }
+    else if (view_callback_) {
+        view_callback_(ByteView(msg));
+    }
+    else if (message_callback_) {
+        std::vector<uint8_t> data(static_cast<uint8_t*>(msg.data()), static_cast<uint8_t*>(msg.data()) + msg.size());
+        message_callback_(data);
+    }
+    metrics_.on_received(size, callback_start);
+}
@@ -1,17 +1,56 @@
 #include "ThreadSafeZMQRequester.h"
 #include <iostream>
+#include <cstring>
 #include "LoggerManager.h"
 
-ThreadSafeZMQRequester::ThreadSafeZMQRequester(zmq::context_t& context, const std::string& address)
-    : context_(context), running_(true), address_(address)
+namespace {
+    constexpr int kMaxRetries = 15; // Դ
+    constexpr auto kPollTimeout = std::chrono::milliseconds(200);
+    constexpr auto kTimerInterval = std::chrono::milliseconds(50);
+}
+
+ThreadSafeZMQRequester::ThreadSafeZMQRequester(zmq::context_t& context, const std::string& address, ZMQReactor* reactor,
+    const SendQueueOptions& queue_options, const RequesterOptions& options, const SocketOptions& socket_options)
+    : context_(context), running_(true), address_(address), request_queue_(queue_options), in_flight_(false), retry_count_(0),
+      options_(options), next_request_id_(1), has_unsent_(false),
+      reactor_(reactor), reactor_id_(-1), timer_id_(-1)
 {
-    socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_REQ);
-    socket_->connect(address_);
-    socket_->set(zmq::sockopt::req_relaxed, 1);
-    spdlog::info("[Requester] Connected to {}", address_);
-    //socket_->set(zmq::sockopt::rcvtimeo, 3000);  // úʱ
+    if (options_.pipelined) {
+        socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_DEALER);
+        // رʱδɵ˵ȴٱ socket ʱһֱȴ
+        socket_->set(zmq::sockopt::linger, 0);
+        socket_options.apply(*socket_);
+        socket_->connect(address_);
+        spdlog::info("[Requester] Connected to {} (pipelined, max in flight: {})", address_, options_.max_in_flight);
+    }
+    else {
+        socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_REQ);
+        socket_->set(zmq::sockopt::req_relaxed, 1);
+        socket_options.apply(*socket_);
+        socket_->connect(address_);
+        spdlog::info("[Requester] Connected to {}", address_);
+        //socket_->set(zmq::sockopt::rcvtimeo, 3000);  // úʱ
+    }
 
-    requester_thread_ = std::thread(&ThreadSafeZMQRequester::requester_loop, this);
+    if (reactor_ && options_.pipelined) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short) {
+            pipeline_receive();
+            pipeline_send();
+            });
+        timer_id_ = reactor_->add_timer(kTimerInterval, [this]() {
+            pipeline_expire();
+            pipeline_send();
+            });
+    }
+    else if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short) { receive_reply(); });
+        timer_id_ = reactor_->add_timer(kTimerInterval, [this]() { check_reply_timeout(); });
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        requester_thread_ = options_.pipelined ? std::thread(&ThreadSafeZMQRequester::pipelined_loop, this)
+                                               : std::thread(&ThreadSafeZMQRequester::requester_loop, this);
+    }
 }
 
 ThreadSafeZMQRequester::~ThreadSafeZMQRequester()
@@ -19,101 +58,364 @@ ThreadSafeZMQRequester::~ThreadSafeZMQRequester()
     spdlog::debug("[Requester] Destruct called");
 
     running_ = false;
-    cv_.notify_all();
+    request_queue_.close();
+    if (signaler_)
+        signaler_->notify();
+    if (reactor_) {
+        reactor_->remove_timer(timer_id_);
+        reactor_->remove_socket(reactor_id_);
+    }
     if (requester_thread_.joinable())
         requester_thread_.join();
 
+    // I/O ֹ߳ͣѻûн Cancelled صȴǵĵ÷һֱ
+    std::vector<StatusCallback> unfinished;
+    for (auto& entry : pending_requests_)
+        unfinished.push_back(std::move(entry.second.callback));
+    pending_requests_.clear();
+    deadlines_.clear();
+    if (has_unsent_)
+        unfinished.push_back(std::move(unsent_.callback));
+    if (in_flight_)
+        unfinished.push_back(std::move(current_.callback));
+    OutgoingRequest queued;
+    while (request_queue_.try_pop(queued))
+        unfinished.push_back(std::move(queued.callback));
+    for (auto& callback : unfinished) {
+        if (callback)
+            callback(RequestStatus::Cancelled, {});
+    }
+
     if (socket_) {
         socket_->close();
         spdlog::info("[Requester] Socket closed");
     }
 }
 
-void ThreadSafeZMQRequester::send_request_async(const std::vector<uint8_t>& data, MessageCallback cb)
+bool ThreadSafeZMQRequester::send_request_async(const std::vector<uint8_t>& data, MessageCallback cb, std::chrono::milliseconds timeout)
+{
+    return send_request_async(ZMQMessageUtils::FromBytes(data), adapt_callback(std::move(cb)), timeout);
+}
+
+bool ThreadSafeZMQRequester::send_request_async(std::vector<uint8_t>&& data, MessageCallback cb, std::chrono::milliseconds timeout)
 {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    request_queue_.push({ data, std::move(cb) });
-    cv_.notify_one();
+    return send_request_async(ZMQMessageUtils::FromBytes(std::move(data)), adapt_callback(std::move(cb)), timeout);
+}
+
+bool ThreadSafeZMQRequester::send_request_async(zmq::message_t&& msg, MessageCallback cb, std::chrono::milliseconds timeout)
+{
+    return send_request_async(std::move(msg), adapt_callback(std::move(cb)), timeout);
+}
+
+bool ThreadSafeZMQRequester::send_request_async(const std::vector<uint8_t>& data, StatusCallback cb, std::chrono::milliseconds timeout)
+{
+    return send_request_async(ZMQMessageUtils::FromBytes(data), std::move(cb), timeout);
+}
+
+bool ThreadSafeZMQRequester::send_request_async(std::vector<uint8_t>&& data, StatusCallback cb, std::chrono::milliseconds timeout)
+{
+    return send_request_async(ZMQMessageUtils::FromBytes(std::move(data)), std::move(cb), timeout);
+}
+
+bool ThreadSafeZMQRequester::send_request_async(zmq::message_t&& msg, StatusCallback cb, std::chrono::milliseconds timeout)
+{
+    if (!request_queue_.push({ std::move(msg), std::move(cb), timeout, SocketMetrics::Clock::now() })) {
+        return false;
+    }
+
+    if (signaler_) {
+        signaler_->notify();
+    }
+
+    if (reactor_ && options_.pipelined) {
+        reactor_->post([this]() { pipeline_send(); });
+    }
+    else if (reactor_) {
+        reactor_->post([this]() { start_next_request(); });
+    }
+    return true;
 }
 
 void ThreadSafeZMQRequester::set_timeout_callback(std::function<void()> callback) {
     timeout_callback_ = std::move(callback);
 }
 
+ThreadSafeZMQRequester::StatusCallback ThreadSafeZMQRequester::adapt_callback(MessageCallback cb)
+{
+    if (!cb)
+        return StatusCallback();
+
+    return [this, cb = std::move(cb)](RequestStatus status, const std::vector<uint8_t>& reply) {
+        if (status == RequestStatus::Ok)
+            cb(reply);
+        else if (status == RequestStatus::Cancelled && timeout_callback_)
+            timeout_callback_();
+    };
+}
+
 void ThreadSafeZMQRequester::requester_loop()
 {
-    constexpr int max_retries = 15; // Դ
-    constexpr auto poll_timeout = std::chrono::milliseconds(200);
+    zmq::pollitem_t items[] = {
+        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 },
+        signaler_->pollitem()
+    };
 
     while (running_) {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        cv_.wait(lock, [this]() {
-            return !request_queue_.empty() || !running_;
-            });
+        start_next_request();
 
-        if (!running_)
-            break;
-
-        auto req = std::move(request_queue_.front());
-        request_queue_.pop();
-        lock.unlock();
-        int retry_count = 0;
-        bool success = false;
-        std::vector<uint8_t> reply_data;
-
-        while (retry_count < max_retries && running_) {
-            // 
-            zmq::message_t msg(req.content.data(), req.content.size());
-            auto res = socket_->send(msg, zmq::send_flags::none);
-            if (!res.has_value()) {
-                spdlog::warn("[Requester] Send failed on retry {}", retry_count);
-                ++retry_count;
-                
-                continue;
-            }
-
-            spdlog::info("[Requester] Sent data size: {}, retry {}", req.content.size(), retry_count);
-            
-            // ȴӦ
-            zmq::pollitem_t items[] = {
-                { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 }
-            };
-            zmq::poll(items, 1, poll_timeout);
-            if (items[0].revents & ZMQ_POLLIN) {
-                zmq::message_t reply_msg;
-                if (socket_->recv(reply_msg, zmq::recv_flags::none)) {
-                    reply_data.assign(
-                        static_cast<uint8_t*>(reply_msg.data()),
-                        static_cast<uint8_t*>(reply_msg.data()) + reply_msg.size()
-                    );
-                    spdlog::info("[Requester] Received response size: {}", reply_msg.size());
-                    success = true;
-                    
-                    break;
-                }
-                else {
-                    spdlog::warn("[Requester] recv failed after poll");
-                }
-            }
-            else {
-                spdlog::warn("[Requester] Poll timeout on retry {}", retry_count);
-            }
-
-            ++retry_count;
+        // ȴӦµ
+        zmq::poll(items, 2, kPollTimeout);
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
         }
 
-        // ûص۳ɹ
-        if (req.callback) {
-            if (success) {
-                req.callback(reply_data);
-            }
-            else {
-                spdlog::warn("[Requester] Max retries reached, sending timeout callback");
-                if (timeout_callback_)
-                    timeout_callback_();
-            }
+        if (items[0].revents & ZMQ_POLLIN) {
+            receive_reply();
+        }
+        else {
+            check_reply_timeout();
         }
     }
 
     spdlog::debug("[Requester] Requester_loop exited");
 }
+
+void ThreadSafeZMQRequester::start_next_request()
+{
+    if (in_flight_)
+        return;
+
+    if (!request_queue_.try_pop(current_))
+        return;
+
+    // ģʽһֻһ;Ŷǻѹ
+    metrics_.observe_queue_depth(request_queue_.size() + 1);
+    retry_count_ = 0;
+    transmit_current();
+}
+
+void ThreadSafeZMQRequester::transmit_current()
+{
+    in_flight_ = true;
+    reply_deadline_ = std::chrono::steady_clock::now() + kPollTimeout;
+
+    // reactor ̲߳ send 
+    auto flags = reactor_ ? zmq::send_flags::dontwait : zmq::send_flags::none;
+    // ҪյӦΪֹcopy ֻüСϢֱӸƣ
+    zmq::message_t msg;
+    msg.copy(current_.content);
+    auto res = socket_->send(msg, flags);
+    if (!res.has_value()) {
+        // ȵֳʱ
+        metrics_.on_send_failure();
+        ZMQ_HOT_WARN("[Requester] Send failed on retry {}", retry_count_);
+        return;
+    }
+
+    // ӳֻͳ״η
+    metrics_.on_sent(current_.content.size(), retry_count_ == 0 ? current_.enqueued_at : SocketMetrics::Clock::time_point());
+    ZMQ_HOT_INFO("[Requester] Sent data size: {}, retry {}", current_.content.size(), retry_count_);
+}
+
+void ThreadSafeZMQRequester::receive_reply()
+{
+    zmq::message_t reply_msg;
+    if (!socket_->recv(reply_msg, zmq::recv_flags::dontwait)) {
+        ZMQ_HOT_WARN("[Requester] recv failed after poll");
+        return;
+    }
+
+    if (!in_flight_) {
+        ZMQ_HOT_WARN("[Requester] Dropped reply without pending request, size: {}", reply_msg.size());
+        return;
+    }
+
+    std::vector<uint8_t> reply_data(
+        static_cast<uint8_t*>(reply_msg.data()),
+        static_cast<uint8_t*>(reply_msg.data()) + reply_msg.size()
+    );
+    ZMQ_HOT_INFO("[Requester] Received response size: {}", reply_msg.size());
+    finish_current(RequestStatus::Ok, reply_data);
+}
+
+void ThreadSafeZMQRequester::check_reply_timeout()
+{
+    if (!in_flight_ || std::chrono::steady_clock::now() < reply_deadline_)
+        return;
+
+    ZMQ_HOT_WARN("[Requester] Poll timeout on retry {}", retry_count_);
+    if (++retry_count_ >= kMaxRetries || !running_) {
+        metrics_.on_timeout();
+        finish_current(RequestStatus::Timeout, {});
+        return;
+    }
+
+    metrics_.on_retry();
+    transmit_current();
+}
+
+void ThreadSafeZMQRequester::finish_current(RequestStatus status, const std::vector<uint8_t>& reply)
+{
+    in_flight_ = false;
+    OutgoingRequest req = std::move(current_);
+
+    // ûص۳ɹ
+    if (status == RequestStatus::Ok) {
+        if (req.callback) {
+            auto callback_start = SocketMetrics::Clock::now();
+            req.callback(status, reply);
+            metrics_.on_received(reply.size(), callback_start);
+        }
+    }
+    else {
+        spdlog::warn("[Requester] Max retries reached, sending timeout callback");
+        if (timeout_callback_)
+            timeout_callback_();
+        if (req.callback)
+            req.callback(status, {});
+    }
+
+    start_next_request();
+}
+
+
+void ThreadSafeZMQRequester::pipelined_loop()
+{
+    zmq::pollitem_t items[] = {
+        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 },
+        signaler_->pollitem()
+    };
+
+    while (running_) {
+        pipeline_send();
+
+        //  EAGAIN ѹһпλʱŹע POLLOUT
+        bool want_send = has_unsent_ && pending_requests_.size() < options_.max_in_flight;
+        items[0].events = want_send ? (ZMQ_POLLIN | ZMQ_POLLOUT) : ZMQ_POLLIN;
+        zmq::poll(items, 2, pipeline_wait_time());
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
+        }
+
+        if (items[0].revents & ZMQ_POLLIN) {
+            pipeline_receive();
+        }
+        pipeline_expire();
+    }
+
+    spdlog::debug("[Requester] Pipelined_loop exited");
+}
+
+void ThreadSafeZMQRequester::pipeline_send()
+{
+    while (pending_requests_.size() < options_.max_in_flight) {
+        if (!has_unsent_) {
+            if (!request_queue_.try_pop(unsent_))
+                return;
+            has_unsent_ = true;
+        }
+
+        // ֡Ϣֻڵһ֡ HWMһ֡֡һ
+        uint64_t request_id = next_request_id_;
+        zmq::message_t id_msg(&request_id, sizeof(request_id));
+        if (!socket_->send(id_msg, zmq::send_flags::sndmore | zmq::send_flags::dontwait).has_value()) {
+            metrics_.observe_queue_depth(request_queue_.size() + 1);
+            return;
+        }
+
+        zmq::message_t delimiter;
+        socket_->send(delimiter, zmq::send_flags::sndmore);
+        size_t size = unsent_.content.size();
+        socket_->send(unsent_.content, zmq::send_flags::none);
+        metrics_.on_sent(size, unsent_.enqueued_at);
+
+        auto timeout = unsent_.timeout.count() > 0 ? unsent_.timeout : options_.request_timeout;
+        auto deadline = deadlines_.emplace(std::chrono::steady_clock::now() + timeout, request_id);
+        pending_requests_.emplace(request_id, PendingRequest{ std::move(unsent_.callback), deadline });
+
+        ++next_request_id_;
+        unsent_ = OutgoingRequest();
+        has_unsent_ = false;
+        ZMQ_HOT_INFO("[Requester] Sent request {} size: {}, in flight: {}", request_id, size, pending_requests_.size());
+    }
+}
+
+void ThreadSafeZMQRequester::pipeline_receive()
+{
+    while (true) {
+        // Ӧ֡[request id][֡][]֡
+        zmq::message_t frames[3];
+        size_t count = 0;
+        if (!socket_->recv(frames[0], zmq::recv_flags::dontwait))
+            return;
+        count = 1;
+
+        bool more = frames[0].more();
+        while (more) {
+            zmq::message_t frame;
+            if (!socket_->recv(frame, zmq::recv_flags::none))
+                break;
+            more = frame.more();
+            if (count < 3)
+                frames[count] = std::move(frame);
+            ++count;
+        }
+
+        if (count != 3 || frames[0].size() != sizeof(uint64_t) || frames[1].size() != 0) {
+            ZMQ_HOT_WARN("[Requester] Dropped malformed reply with {} frames", count);
+            continue;
+        }
+
+        uint64_t request_id;
+        std::memcpy(&request_id, frames[0].data(), sizeof(request_id));
+        auto it = pending_requests_.find(request_id);
+        if (it == pending_requests_.end()) {
+            ZMQ_HOT_WARN("[Requester] Dropped late reply for request {}, size: {}", request_id, frames[2].size());
+            continue;
+        }
+
+        StatusCallback callback = std::move(it->second.callback);
+        deadlines_.erase(it->second.deadline);
+        pending_requests_.erase(it);
+
+        ZMQ_HOT_INFO("[Requester] Received response {} size: {}", request_id, frames[2].size());
+        if (callback) {
+            const zmq::message_t& body = frames[2];
+            std::vector<uint8_t> reply_data(
+                static_cast<const uint8_t*>(body.data()),
+                static_cast<const uint8_t*>(body.data()) + body.size()
+            );
+            auto callback_start = SocketMetrics::Clock::now();
+            callback(RequestStatus::Ok, reply_data);
+            metrics_.on_received(reply_data.size(), callback_start);
+        }
+    }
+}
+
+void ThreadSafeZMQRequester::pipeline_expire()
+{
+    auto now = std::chrono::steady_clock::now();
+    while (!deadlines_.empty() && deadlines_.begin()->first <= now) {
+        uint64_t request_id = deadlines_.begin()->second;
+        deadlines_.erase(deadlines_.begin());
+        auto it = pending_requests_.find(request_id);
+        StatusCallback callback = std::move(it->second.callback);
+        pending_requests_.erase(it);
+        metrics_.on_timeout();
+
+        spdlog::warn("[Requester] Request {} timed out", request_id);
+        if (timeout_callback_)
+            timeout_callback_();
+        if (callback)
+            callback(RequestStatus::Timeout, {});
+    }
+}
+
+std::chrono::milliseconds ThreadSafeZMQRequester::pipeline_wait_time() const
+{
+    if (deadlines_.empty())
+        return kPollTimeout;
+
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadlines_.begin()->first - std::chrono::steady_clock::now());
+    return (std::max)(std::chrono::milliseconds(0), (std::min)(left + std::chrono::milliseconds(1), kPollTimeout));
+}
@@ -1,18 +1,37 @@
 #include "ThreadSafeZMQRouter.h"
 #include "LoggerManager.h"
 #include "HexUtils.h"
+#include "ZMQMessageUtils.h"
 
-ThreadSafeZMQRouter::ThreadSafeZMQRouter(zmq::context_t& context, const std::string& address)
-    : context_(context), address_(address), running_(true) {
+ThreadSafeZMQRouter::ThreadSafeZMQRouter(zmq::context_t& context, const std::string& address, ZMQReactor* reactor,
+    const SocketOptions& socket_options, const RouterOptions& router_options)
+    : context_(context), address_(address), running_(true), identities_(router_options.identity_capacity), reactor_(reactor), reactor_id_(-1) {
     socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_ROUTER);
+    socket_options.apply(*socket_);
+#ifdef ZMQ_ROUTER_NOTIFY
+    // libzmq Բݰ API ʱԶ˶Ͽյ [id][֡]ݴ˰ŵ identity ̭λ
+    socket_->set(zmq::sockopt::router_notify, ZMQ_NOTIFY_DISCONNECT);
+#endif
     socket_->bind(address_);
     spdlog::info("[Router] Bound to {}", address_);
 
-    router_thread_ = std::thread(&ThreadSafeZMQRouter::router_loop, this);
+    if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short) { receive_available(); });
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        router_thread_ = std::thread(&ThreadSafeZMQRouter::router_loop, this);
+    }
 }
 
 ThreadSafeZMQRouter::~ThreadSafeZMQRouter() {
     running_ = false;
+    send_queue_.close();
+    if (signaler_)
+        signaler_->notify();
+
+    if (reactor_)
+        reactor_->remove_socket(reactor_id_);
 
     if (router_thread_.joinable())
         router_thread_.join();
@@ -22,50 +41,222 @@ ThreadSafeZMQRouter::~ThreadSafeZMQRouter() {
 }
 
 void ThreadSafeZMQRouter::set_callback(MessageCallback cb) {
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    handle_callback_ = nullptr;
     message_callback_ = std::move(cb);
 }
 
+void ThreadSafeZMQRouter::set_view_callback(ViewCallback cb) {
+    message_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    handle_callback_ = nullptr;
+    view_callback_ = std::move(cb);
+}
+
+void ThreadSafeZMQRouter::set_message_callback(OwnedMessageCallback cb) {
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    handle_callback_ = nullptr;
+    owned_callback_ = std::move(cb);
+}
+
+void ThreadSafeZMQRouter::set_handle_callback(HandleCallback cb) {
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    handle_callback_ = std::move(cb);
+}
+
+void ThreadSafeZMQRouter::set_batch_end_callback(std::function<void()> callback) {
+    batch_end_callback_ = std::move(callback);
+}
+
+void ThreadSafeZMQRouter::set_request_callback(RequestCallback cb) {
+    request_callback_ = std::move(cb);
+}
+
 void ThreadSafeZMQRouter::send_to(const std::vector<uint8_t>& identity, const std::vector<uint8_t>& data) {
-    std::lock_guard<std::mutex> lock(send_mutex_);
+    send_to(identity, 0, data);
+}
+
+void ThreadSafeZMQRouter::send_to(const std::vector<uint8_t>& identity, uint64_t correlation_id, const std::vector<uint8_t>& data) {
+    // socket ֻ I/O ߳ʹãreactor ģʽͶݵ reactor ̣߳߳ģʽ router_loop
+    if (!reactor_) {
+        enqueue(OutgoingReply{ RouterIdentityTable::kInvalidHandle, identity, correlation_id, data });
+        return;
+    }
+    if (!reactor_->in_reactor_thread()) {
+        reactor_->post([this, identity, correlation_id, data]() { send_now(identity, correlation_id, data); });
+        return;
+    }
+    send_now(identity, correlation_id, data);
+}
+
+void ThreadSafeZMQRouter::send_to(PeerHandle peer, const std::vector<uint8_t>& data) {
+    send_to(peer, 0, data);
+}
+
+void ThreadSafeZMQRouter::send_to(PeerHandle peer, uint64_t correlation_id, const std::vector<uint8_t>& data) {
+    if (!reactor_) {
+        enqueue(OutgoingReply{ peer, std::vector<uint8_t>(), correlation_id, data });
+        return;
+    }
+    if (!reactor_->in_reactor_thread()) {
+        reactor_->post([this, peer, correlation_id, data]() { send_now(peer, correlation_id, data); });
+        return;
+    }
+    send_now(peer, correlation_id, data);
+}
+
+void ThreadSafeZMQRouter::enqueue(OutgoingReply&& reply) {
+    if (!send_queue_.push(std::move(reply))) {
+        metrics_.on_send_failure();
+        return;
+    }
+    signaler_->notify();
+}
+
+void ThreadSafeZMQRouter::send_queued() {
+    std::deque<OutgoingReply> local_queue;
+    send_queue_.drain(local_queue);
+    metrics_.observe_queue_depth(local_queue.size());
+
+    for (const auto& reply : local_queue) {
+        if (reply.peer != RouterIdentityTable::kInvalidHandle)
+            send_now(reply.peer, reply.correlation_id, reply.data);
+        else
+            send_now(reply.identity, reply.correlation_id, reply.data);
+    }
+}
+
+void ThreadSafeZMQRouter::send_now(const std::vector<uint8_t>& identity, uint64_t correlation_id, const std::vector<uint8_t>& data) {
     zmq::message_t id_msg(identity.data(), identity.size());
-    zmq::message_t empty_msg(0);
+    if (!send_frames(id_msg, correlation_id, data))
+        spdlog::error("[Router] Failed to send message to {}", HexUtils::BytesToHex(identity));
+}
+
+void ThreadSafeZMQRouter::send_now(PeerHandle peer, uint64_t correlation_id, const std::vector<uint8_t>& data) {
+    // ڷʱŽŶڼԶ˱̭Ϣﶪ
+    zmq::message_t id_msg;
+    if (!identities_.resolve(peer, id_msg)) {
+        metrics_.on_send_failure();
+        ZMQ_HOT_WARN("[Router] Dropped message to stale peer {}", peer);
+        return;
+    }
+    if (!send_frames(id_msg, correlation_id, data))
+        spdlog::error("[Router] Failed to send message to peer {}", peer);
+}
+
+bool ThreadSafeZMQRouter::send_frames(zmq::message_t& id_msg, uint64_t correlation_id, const std::vector<uint8_t>& data) {
+    zmq::message_t empty_msg = correlation_id != 0 ? ZMQMessageUtils::MakeCorrelationFrame(correlation_id) : zmq::message_t(0);
     zmq::message_t data_msg(data.data(), data.size());
 
     auto r1 = socket_->send(id_msg, zmq::send_flags::sndmore);
     auto r2 = socket_->send(empty_msg, zmq::send_flags::sndmore);
     auto r3 = socket_->send(data_msg, zmq::send_flags::none);
 
-    if (!r1.has_value() || !r2.has_value() || !r3.has_value()) {
-        spdlog::error("[Router] Failed to send message to {}", HexUtils::BytesToHex(identity));
+    if (r1.has_value() && r2.has_value() && r3.has_value()) {
+        metrics_.on_sent(data.size());
+        return true;
     }
+    metrics_.on_send_failure();
+    return false;
 }
 
 void ThreadSafeZMQRouter::router_loop() {
     zmq::pollitem_t items[] = {
-        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 }
+        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 },
+        signaler_->pollitem()
     };
 
     while (running_) {
-        zmq::poll(items, 1, std::chrono::milliseconds(200));
+        zmq::poll(items, 2, std::chrono::milliseconds(200));
+
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
+        }
 
         if (items[0].revents & ZMQ_POLLIN) {
-            zmq::message_t identity;
-            zmq::message_t content;
+            receive_available();
+        }
+
+        // ղŻصͬĻظ
+        send_queued();
+    }
 
-            if (socket_->recv(identity, zmq::recv_flags::none) &&
-                socket_->recv(content, zmq::recv_flags::none)) {
+    spdlog::debug("[Router] Router_loop exited");
+}
 
-                std::vector<uint8_t> id_vec(static_cast<uint8_t*>(identity.data()), static_cast<uint8_t*>(identity.data()) + identity.size());
-                std::vector<uint8_t> data(static_cast<uint8_t*>(content.data()), static_cast<uint8_t*>(content.data()) + content.size());
+void ThreadSafeZMQRouter::receive_available() {
+    // һξ¼ȡѵϢͬһ reactor ϵ socket
+    size_t count = 0;
+    while (count < ZMQReactor::kMaxReceiveBatch && receive_one())
+        ++count;
+    if (count > 0 && batch_end_callback_)
+        batch_end_callback_();
+}
 
-                spdlog::info("[Router] Received from id: {}, size: {}", HexUtils::BytesToHex(id_vec), data.size());
+bool ThreadSafeZMQRouter::receive_one() {
+    zmq::message_t identity;
+    zmq::message_t content;
 
-                if (message_callback_) {
-                    message_callback_(id_vec, data);
-                }
-            }
+    if (!socket_->recv(identity, zmq::recv_flags::dontwait))
+        return false;
+
+    if (socket_->recv(content, zmq::recv_flags::none)) {
+#ifdef ZMQ_ROUTER_NOTIFY
+        bool multipart = content.more();
+#endif
+
+        // request_async  [id][֡][data]ֻ֡һ֡Ϊ
+        uint64_t correlation_id = 0;
+        bool correlated = false;
+        while (socket_->get(zmq::sockopt::rcvmore)) {
+            zmq::message_t next;
+            if (!socket_->recv(next, zmq::recv_flags::none))
+                break;
+            if (!correlated)
+                correlated = ZMQMessageUtils::ParseCorrelationFrame(content, correlation_id);
+            content = std::move(next);
         }
-    }
 
-    spdlog::debug("[Router] Router_loop exited");
+        ByteView id_view(identity);
+        PeerHandle peer = identities_.intern(id_view);
+        ZMQ_HOT_INFO("[Router] Received from peer: {}, size: {}", peer, content.size());
+
+        size_t size = content.size();
+        auto callback_start = SocketMetrics::Clock::now();
+
+        if (correlated && request_callback_) {
+            request_callback_(id_view, correlation_id, ByteView(content));
+            metrics_.on_received(size, callback_start);
+            return true;
+        }
+
+        if (handle_callback_) {
+            handle_callback_(peer, std::move(content));
+        }
+        else if (owned_callback_) {
+            owned_callback_(id_view, std::move(content));
+        }
+        else if (view_callback_) {
+            view_callback_(id_view, ByteView(content));
+        }
+        else if (message_callback_) {
+            std::vector<uint8_t> id_vec = id_view.to_vector();
+            std::vector<uint8_t> data(static_cast<uint8_t*>(content.data()), static_cast<uint8_t*>(content.data()) + content.size());
+            message_callback_(id_vec, data);
+        }
+        metrics_.on_received(size, callback_start);
+
+#ifdef ZMQ_ROUTER_NOTIFY
+        // Ͽ֪ͨԶ˷ĵ֡޷֣ճֻ̭ȼʹʧЧ
+        if (!multipart && size == 0) {
+            identities_.retire(peer);
+            ZMQ_HOT_INFO("[Router] Peer {} sent an empty frame or disconnected, retired", peer);
+        }
+#endif
+    }
+    return true;
 }
\ No newline at end of file
@@ -1,11 +1,23 @@
 #include "ThreadSafeZMQSubscriber.h"
 #include <iostream>
 #include "LoggerManager.h"
+#include "ZMQMessageUtils.h"
 
-ThreadSafeZMQSubscriber::ThreadSafeZMQSubscriber(zmq::context_t& context, const std::string& address, const std::string& topicFilter, bool isBind)
-    : context_(context), running_(true), address_(address), topic_filter_(topicFilter), isBind_(isBind)
+namespace {
+    // 鲹ʱļ
+    constexpr auto kRecoveryTick = std::chrono::milliseconds(20);
+    // һ topic ڼݴϢβ
+    constexpr size_t kMaxHeldMessages = 4096;
+}
+
+ThreadSafeZMQSubscriber::ThreadSafeZMQSubscriber(zmq::context_t& context, const std::string& address, const std::string& topicFilter, bool isBind, ZMQReactor* reactor,
+    const SocketOptions& socket_options, const SubscriberOptions& subscriber_options)
+    : context_(context), running_(true), address_(address), topic_filter_(topicFilter), isBind_(isBind),
+      has_topic_callbacks_(false), recovering_topics_(0), recover_gaps_(false), recovery_timeout_(subscriber_options.recovery_timeout),
+      recovery_timer_id_(-1), reactor_(reactor), reactor_id_(-1), snapshot_reactor_id_(-1), alive_(std::make_shared<std::atomic<bool>>(true))
 {
     socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_SUB);
+    socket_options.apply(*socket_);
     if (isBind_) {
         socket_->bind(address_);
         spdlog::info("[Subscriber] Bound to {}", address_);
@@ -16,16 +28,55 @@ ThreadSafeZMQSubscriber::ThreadSafeZMQSubscriber(zmq::context_t& context, const
     }
 
     socket_->set(zmq::sockopt::subscribe, topic_filter_);
+    subscriptions_[topic_filter_].default_callback = true;
+    rebuild_topic_trie();
+
+    // ȶգ֮󷢲Ϣһܴ SUB յڿյŹ
+    if (!subscriber_options.snapshot_address.empty()) {
+        snapshot_socket_ = std::make_unique<zmq::socket_t>(context_, ZMQ_DEALER);
+        snapshot_socket_->set(zmq::sockopt::linger, 0);
+        snapshot_socket_->connect(subscriber_options.snapshot_address);
+        spdlog::info("[Subscriber] Snapshot service at {}", subscriber_options.snapshot_address);
+        recover_gaps_ = subscriber_options.recover_gaps;
+        request_snapshot(topic_filter_);
+    }
+    else if (subscriber_options.recover_gaps) {
+        spdlog::warn("[Subscriber] recover_gaps ignored without a snapshot_address");
+    }
 
-    subscriber_thread_ = std::thread(&ThreadSafeZMQSubscriber::subscriber_loop, this);
+    if (reactor_) {
+        reactor_id_ = reactor_->add_socket(*socket_, ZMQ_POLLIN, [this](short) { receive_available(); });
+        if (snapshot_socket_)
+            snapshot_reactor_id_ = reactor_->add_socket(*snapshot_socket_, ZMQ_POLLIN, [this](short) { receive_replies(); });
+        if (recover_gaps_) {
+            recovery_timer_id_ = reactor_->add_timer(kRecoveryTick, [this]() {
+                if (expire_recoveries() > 0 && batch_end_callback_)
+                    batch_end_callback_();
+                });
+        }
+    }
+    else {
+        signaler_ = std::make_unique<ZMQSignaler>(context_);
+        subscriber_thread_ = std::thread(&ThreadSafeZMQSubscriber::subscriber_loop, this);
+    }
 }
 
 ThreadSafeZMQSubscriber::~ThreadSafeZMQSubscriber()
 {
     running_ = false;
+    alive_->store(false);
+    if (reactor_) {
+        if (recover_gaps_)
+            reactor_->remove_timer(recovery_timer_id_);
+        if (snapshot_socket_)
+            reactor_->remove_socket(snapshot_reactor_id_);
+        reactor_->remove_socket(reactor_id_);
+    }
     if (subscriber_thread_.joinable())
         subscriber_thread_.join();
 
+    if (snapshot_socket_)
+        snapshot_socket_->close();
     if (socket_) {
         socket_->close();
         spdlog::info("[Subscriber] Socket closed");
@@ -34,47 +85,502 @@ ThreadSafeZMQSubscriber::~ThreadSafeZMQSubscriber()
 
 void ThreadSafeZMQSubscriber::set_callback(MessageCallback cb)
 {
+    view_callback_ = nullptr;
+    owned_callback_ = nullptr;
     message_callback_ = std::move(cb);
 }
 
+void ThreadSafeZMQSubscriber::set_view_callback(ViewCallback cb)
+{
+    message_callback_ = nullptr;
+    owned_callback_ = nullptr;
+    view_callback_ = std::move(cb);
+}
+
+void ThreadSafeZMQSubscriber::set_message_callback(OwnedMessageCallback cb)
+{
+    message_callback_ = nullptr;
+    view_callback_ = nullptr;
+    owned_callback_ = std::move(cb);
+}
+
+void ThreadSafeZMQSubscriber::set_batch_end_callback(std::function<void()> callback)
+{
+    batch_end_callback_ = std::move(callback);
+}
+
+void ThreadSafeZMQSubscriber::subscribe(const std::string& topic)
+{
+    post_change({ SubscriptionChange::Kind::AddDefault, topic, nullptr });
+}
+
+void ThreadSafeZMQSubscriber::subscribe(const std::string& topic, TopicCallback callback, TopicMatch match)
+{
+    if (!callback) {
+        spdlog::warn("[Subscriber] Ignored subscribe to {} without a callback", topic);
+        return;
+    }
+    auto kind = match == TopicMatch::Exact ? SubscriptionChange::Kind::AddExact : SubscriptionChange::Kind::AddPrefix;
+    post_change({ kind, topic, std::move(callback) });
+}
+
+void ThreadSafeZMQSubscriber::unsubscribe(const std::string& topic)
+{
+    post_change({ SubscriptionChange::Kind::Remove, topic, nullptr });
+}
+
+void ThreadSafeZMQSubscriber::post_change(SubscriptionChange change)
+{
+    {
+        std::lock_guard<std::mutex> lock(changes_mutex_);
+        pending_changes_.push_back(std::move(change));
+    }
+
+    if (reactor_) {
+        auto alive = alive_;
+        reactor_->post([this, alive]() {
+            if (alive->load())
+                apply_changes();
+            });
+    }
+    else {
+        signaler_->notify();
+    }
+}
+
+void ThreadSafeZMQSubscriber::apply_changes()
+{
+    std::vector<SubscriptionChange> changes;
+    {
+        std::lock_guard<std::mutex> lock(changes_mutex_);
+        changes.swap(pending_changes_);
+    }
+    if (changes.empty())
+        return;
+
+    for (auto& change : changes) {
+        auto it = subscriptions_.find(change.topic);
+        if (change.kind == SubscriptionChange::Kind::Remove) {
+            if (it == subscriptions_.end())
+                continue;
+            subscriptions_.erase(it);
+            socket_->set(zmq::sockopt::unsubscribe, change.topic);
+            if (snapshot_socket_)
+                forget_sequences(change.topic);
+            spdlog::info("[Subscriber] Unsubscribed from '{}'", change.topic);
+            continue;
+        }
+
+        // libzmq ظļͬһ topic ֻһ
+        if (it == subscriptions_.end()) {
+            it = subscriptions_.emplace(change.topic, Subscription()).first;
+            socket_->set(zmq::sockopt::subscribe, change.topic);
+            spdlog::info("[Subscriber] Subscribed to '{}'", change.topic);
+            if (snapshot_socket_)
+                request_snapshot(change.topic);
+        }
+
+        switch (change.kind) {
+        case SubscriptionChange::Kind::AddDefault: it->second.default_callback = true; break;
+        case SubscriptionChange::Kind::AddPrefix: it->second.prefix_callback = std::move(change.callback); break;
+        case SubscriptionChange::Kind::AddExact: it->second.exact_callback = std::move(change.callback); break;
+        default: break;
+        }
+    }
+
+    rebuild_topic_trie();
+}
+
+void ThreadSafeZMQSubscriber::rebuild_topic_trie()
+{
+    std::vector<TopicTrie::Entry> entries;
+    topic_handlers_.clear();
+    has_topic_callbacks_ = false;
+
+    for (auto& [topic, subscription] : subscriptions_) {
+        TopicTrie::Entry entry;
+        entry.key = topic;
+        uint32_t index = static_cast<uint32_t>(topic_handlers_.size());
+        topic_handlers_.push_back(&subscription);
+        if (subscription.default_callback || subscription.prefix_callback)
+            entry.prefix = index;
+        if (subscription.exact_callback)
+            entry.exact = index;
+        has_topic_callbacks_ = has_topic_callbacks_ || subscription.prefix_callback || subscription.exact_callback;
+        entries.push_back(std::move(entry));
+    }
+
+    topic_trie_.build(std::move(entries));
+    spdlog::debug("[Subscriber] Topic trie rebuilt: {} subscriptions, {} nodes", subscriptions_.size(), topic_trie_.node_count());
+}
+
 void ThreadSafeZMQSubscriber::subscriber_loop()
 {
     zmq::pollitem_t items[] = {
-        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 }
+        { static_cast<void*>(*socket_), 0, ZMQ_POLLIN, 0 },
+        signaler_->pollitem(),
+        { snapshot_socket_ ? static_cast<void*>(*snapshot_socket_) : nullptr, 0, ZMQ_POLLIN, 0 }
     };
+    int item_count = snapshot_socket_ ? 3 : 2;
 
     while (running_) {
-        // ѯ socketʱ 100ms
-        zmq::poll(items, 1, std::chrono::milliseconds(200));
+        // ѯ socketʱ 200ms topic ڵȲʱ̣Ա㰴ʱ
+        zmq::poll(items, item_count, recovering_topics_ > 0 ? kRecoveryTick : std::chrono::milliseconds(200));
+
+        // ı仯Ч֮յϢµĶķַ
+        if (items[1].revents & ZMQ_POLLIN) {
+            signaler_->consume();
+            apply_changes();
+        }
 
         // ݿɶ
         if (items[0].revents & ZMQ_POLLIN) {
-            zmq::message_t topic_msg;
-            zmq::message_t body_msg;
+            receive_available();
+        }
 
-            if (!socket_->recv(topic_msg, zmq::recv_flags::none)) {
-                spdlog::warn("[Subscriber] Failed to receive topic frame");
-                continue;
-            }
+        if (snapshot_socket_ && (items[2].revents & ZMQ_POLLIN)) {
+            receive_replies();
+        }
 
-            if (!socket_->recv(body_msg, zmq::recv_flags::none)) {
-                spdlog::warn("[Subscriber] Missing data frame");
-                continue;
-            }
+        if (expire_recoveries() > 0 && batch_end_callback_) {
+            batch_end_callback_();
+        }
+    }
+
+    spdlog::debug("[Subscriber] subscriber_loop exited");
+}
+
+void ThreadSafeZMQSubscriber::receive_available()
+{
+    // һξ¼ȡѵϢͬһ reactor ϵ socket
+    size_t count = 0;
+    while (count < ZMQReactor::kMaxReceiveBatch && receive_one())
+        ++count;
+    if (count > 0 && batch_end_callback_)
+        batch_end_callback_();
+}
+
+bool ThreadSafeZMQSubscriber::receive_one()
+{
+    zmq::message_t topic_msg;
+    zmq::message_t body_msg;
+
+    if (!socket_->recv(topic_msg, zmq::recv_flags::dontwait))
+        return false;
 
-            std::string topic(static_cast<char*>(topic_msg.data()), topic_msg.size());
-            std::vector<uint8_t> data(
-                static_cast<uint8_t*>(body_msg.data()),
-                static_cast<uint8_t*>(body_msg.data()) + body_msg.size()
-            );
+    if (!socket_->recv(body_msg, zmq::recv_flags::none)) {
+        ZMQ_HOT_WARN("[Subscriber] Missing data frame");
+        return true;
+    }
 
-            if (message_callback_) {
-                message_callback_(topic, data);
+    // ÿշʱϢ֡
+    uint64_t sequence = 0;
+    if (body_msg.more()) {
+        zmq::message_t extra;
+        while (socket_->recv(extra, zmq::recv_flags::none)) {
+            ZMQMessageUtils::ParseSequenceFrame(extra, sequence);
+            if (!extra.more())
+                break;
+        }
+    }
+
+    std::string_view topic(static_cast<const char*>(topic_msg.data()), topic_msg.size());
+    ZMQ_HOT_INFO("[Subscriber] Received topic: {}, size: {}", topic, body_msg.size());
+    if (snapshot_socket_ && sequence != 0)
+        on_sequenced(topic, sequence, std::move(body_msg));
+    else
+        deliver(topic, std::move(body_msg));
+    return true;
+}
+
+void ThreadSafeZMQSubscriber::request_snapshot(const std::string& prefix)
+{
+    // ROUTER Զ identity˻ûʱ DEALER ĶϺ󷢳
+    // ֡Ϣֻڵһ֡ HWMһ֡֡һ
+    uint8_t tag = ZMQMessageUtils::kSnapshotTag;
+    if (!snapshot_socket_->send(zmq::message_t(&tag, sizeof(tag)), zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
+        spdlog::warn("[Subscriber] Snapshot request for '{}' dropped", prefix);
+        return;
+    }
+    snapshot_socket_->send(zmq::message_t(prefix.data(), prefix.size()), zmq::send_flags::dontwait);
+}
+
+void ThreadSafeZMQSubscriber::receive_replies()
+{
+    int delivered = 0;
+    zmq::message_t tag;
+    while (snapshot_socket_->recv(tag, zmq::recv_flags::dontwait)) {
+        uint8_t kind = tag.size() == 1 ? *static_cast<const uint8_t*>(tag.data()) : 0;
+        if (kind == ZMQMessageUtils::kSnapshotTag) {
+            delivered += receive_snapshot(tag);
+        }
+        else if (kind == ZMQMessageUtils::kRetransmitTag) {
+            delivered += receive_retransmit(tag);
+        }
+        else {
+            spdlog::warn("[Subscriber] Ignored malformed reply");
+            while (tag.more() && snapshot_socket_->recv(tag, zmq::recv_flags::none)) {
             }
+        }
+    }
 
-            spdlog::info("[Subscriber] Received topic: {}, size: {}", topic, body_msg.size());
+    if (delivered > 0 && batch_end_callback_)
+        batch_end_callback_();
+}
+
+int ThreadSafeZMQSubscriber::receive_snapshot(const zmq::message_t& tag)
+{
+    // [kSnapshotTag] ֮ÿ topic Ϊ [topic][֡][body]
+    int delivered = 0;
+    size_t topics = 0;
+    bool more = tag.more();
+    while (more) {
+        zmq::message_t topic_msg;
+        zmq::message_t sequence_msg;
+        zmq::message_t body_msg;
+        if (!snapshot_socket_->recv(topic_msg, zmq::recv_flags::none) || !topic_msg.more() ||
+            !snapshot_socket_->recv(sequence_msg, zmq::recv_flags::none) || !sequence_msg.more() ||
+            !snapshot_socket_->recv(body_msg, zmq::recv_flags::none)) {
+            spdlog::warn("[Subscriber] Truncated snapshot reply");
+            break;
         }
+        more = body_msg.more();
+        ++topics;
+
+        // ʷϢȱڣڲ topic Ȳÿո
+        uint64_t sequence = 0;
+        if (!ZMQMessageUtils::ParseSequenceFrame(sequence_msg, sequence))
+            continue;
+        TopicSequence& state = sequence_of(topic_msg.to_string_view())->second;
+        if (sequence <= state.delivered || state.recovering_to != 0)
+            continue;
+
+        state.delivered = sequence;
+        deliver(topic_msg.to_string_view(), std::move(body_msg));
+        ++delivered;
     }
 
-    spdlog::debug("[Subscriber] subscriber_loop exited");
+    spdlog::info("[Subscriber] Received snapshot of {} topics", topics);
+    return delivered;
+}
+
+int ThreadSafeZMQSubscriber::receive_retransmit(const zmq::message_t& tag)
+{
+    // [kRetransmitTag][topic][֡] ֮ [֡][body]
+    zmq::message_t topic_msg;
+    zmq::message_t to_msg;
+    uint64_t to = 0;
+    if (!tag.more() || !snapshot_socket_->recv(topic_msg, zmq::recv_flags::none) || !topic_msg.more() ||
+        !snapshot_socket_->recv(to_msg, zmq::recv_flags::none) || !ZMQMessageUtils::ParseSequenceFrame(to_msg, to)) {
+        spdlog::warn("[Subscriber] Ignored malformed retransmit reply");
+        zmq::message_t rest;
+        while (snapshot_socket_->get(zmq::sockopt::rcvmore) && snapshot_socket_->recv(rest, zmq::recv_flags::none)) {
+        }
+        return 0;
+    }
+
+    std::vector<std::pair<uint64_t, zmq::message_t>> entries;
+    bool more = to_msg.more();
+    while (more) {
+        zmq::message_t sequence_msg;
+        zmq::message_t body_msg;
+        uint64_t sequence = 0;
+        if (!snapshot_socket_->recv(sequence_msg, zmq::recv_flags::none) || !sequence_msg.more() ||
+            !snapshot_socket_->recv(body_msg, zmq::recv_flags::none)) {
+            spdlog::warn("[Subscriber] Truncated retransmit reply");
+            break;
+        }
+        more = body_msg.more();
+        if (ZMQMessageUtils::ParseSequenceFrame(sequence_msg, sequence))
+            entries.emplace_back(sequence, std::move(body_msg));
+    }
+
+    // ʱŵĻظٴǶȱѾΪʧ
+    std::string topic = topic_msg.to_string();
+    auto it = topic_sequences_.find(topic);
+    if (it == topic_sequences_.end() || it->second.recovering_to != to)
+        return 0;
+
+    TopicSequence& state = it->second;
+    int delivered = 0;
+    for (auto& [sequence, body] : entries) {
+        if (sequence <= state.delivered || sequence > state.recovering_to)
+            continue;
+        if (sequence > state.delivered + 1)
+            metrics_.on_lost(sequence - state.delivered - 1);
+        state.delivered = sequence;
+        deliver(topic, std::move(body));
+        ++delivered;
+    }
+
+    ZMQ_HOT_INFO("[Subscriber] Recovered {} messages for topic {}", entries.size(), topic);
+    return delivered + finish_recovery(topic, state);
+}
+
+ThreadSafeZMQSubscriber::TopicSequences::iterator ThreadSafeZMQSubscriber::sequence_of(std::string_view topic)
+{
+    auto it = topic_sequences_.lower_bound(topic);
+    if (it == topic_sequences_.end() || it->first != topic)
+        it = topic_sequences_.emplace_hint(it, std::string(topic), TopicSequence());
+    return it;
+}
+
+int ThreadSafeZMQSubscriber::on_sequenced(std::string_view topic, uint64_t sequence, zmq::message_t&& body)
+{
+    auto it = sequence_of(topic);
+    TopicSequence& state = it->second;
+    if (sequence <= state.delivered) {
+        ZMQ_HOT_INFO("[Subscriber] Dropped stale topic: {}, sequence: {}", topic, sequence);
+        return 0;
+    }
+
+    if (state.recovering_to != 0) {
+        state.held.emplace(sequence, std::move(body));
+        if (state.held.size() <= kMaxHeldMessages)
+            return 0;
+        spdlog::warn("[Subscriber] Gave up recovery of topic {} after holding {} messages", topic, state.held.size());
+        return finish_recovery(it->first, state);
+    }
+
+    // һϢΪ׼֮ŲмϢ HWM ϶
+    if (state.delivered != 0 && sequence > state.delivered + 1) {
+        if (recover_gaps_) {
+            state.held.emplace(sequence, std::move(body));
+            start_recovery(it->first, state, state.delivered + 1, sequence - 1);
+            return 0;
+        }
+        metrics_.on_lost(sequence - state.delivered - 1);
+    }
+
+    state.delivered = sequence;
+    deliver(topic, std::move(body));
+    return 1;
+}
+
+void ThreadSafeZMQSubscriber::start_recovery(const std::string& topic, TopicSequence& state, uint64_t from, uint64_t to)
+{
+    state.recovering_to = to;
+    state.deadline = SocketMetrics::Clock::now() + recovery_timeout_;
+    ++recovering_topics_;
+    metrics_.on_retry();
+
+    // 󷢲ȥʱȳʱ
+    uint8_t tag = ZMQMessageUtils::kRetransmitTag;
+    if (!snapshot_socket_->send(zmq::message_t(&tag, sizeof(tag)), zmq::send_flags::sndmore | zmq::send_flags::dontwait)) {
+        spdlog::warn("[Subscriber] Retransmit request for topic {} dropped", topic);
+        return;
+    }
+    snapshot_socket_->send(zmq::message_t(topic.data(), topic.size()), zmq::send_flags::sndmore);
+    snapshot_socket_->send(ZMQMessageUtils::MakeSequenceFrame(from), zmq::send_flags::sndmore);
+    snapshot_socket_->send(ZMQMessageUtils::MakeSequenceFrame(to), zmq::send_flags::none);
+
+    ZMQ_HOT_INFO("[Subscriber] Gap on topic {}: requesting {}..{}", topic, from, to);
+}
+
+int ThreadSafeZMQSubscriber::finish_recovery(const std::string& topic, TopicSequence& state)
+{
+    // ûĲּΪʧٰ˳򽻸ݴϢݴϢ֮仹ȱʱ
+    if (state.delivered < state.recovering_to) {
+        metrics_.on_lost(state.recovering_to - state.delivered);
+        state.delivered = state.recovering_to;
+    }
+    state.recovering_to = 0;
+    --recovering_topics_;
+
+    int delivered = 0;
+    while (!state.held.empty()) {
+        auto it = state.held.begin();
+        if (it->first > state.delivered + 1) {
+            start_recovery(topic, state, state.delivered + 1, it->first - 1);
+            break;
+        }
+        if (it->first > state.delivered) {
+            state.delivered = it->first;
+            deliver(topic, std::move(it->second));
+            ++delivered;
+        }
+        state.held.erase(it);
+    }
+    return delivered;
+}
+
+int ThreadSafeZMQSubscriber::expire_recoveries()
+{
+    if (recovering_topics_ == 0)
+        return 0;
+
+    int delivered = 0;
+    auto now = SocketMetrics::Clock::now();
+    for (auto& [topic, state] : topic_sequences_) {
+        if (state.recovering_to == 0 || now < state.deadline)
+            continue;
+        spdlog::warn("[Subscriber] Retransmit for topic {} timed out", topic);
+        metrics_.on_timeout();
+        delivered += finish_recovery(topic, state);
+    }
+    return delivered;
+}
+
+void ThreadSafeZMQSubscriber::forget_sequences(const std::string& prefix)
+{
+    // ˶ٶʱյϢΪ׼˶ڼϢȱ
+    //  prefix ͷ topic һ
+    for (auto it = topic_sequences_.lower_bound(prefix); it != topic_sequences_.end();) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0)
+            break;
+        if (it->second.recovering_to != 0)
+            --recovering_topics_;
+        it = topic_sequences_.erase(it);
+    }
+}
+
+void ThreadSafeZMQSubscriber::deliver(std::string_view topic, zmq::message_t&& body)
+{
+    size_t size = body.size();
+    auto callback_start = SocketMetrics::Clock::now();
+    if (has_topic_callbacks_)
+        dispatch(topic, std::move(body));
+    else
+        dispatch_default(topic, std::move(body));
+    metrics_.on_received(topic.size() + size, callback_start);
+}
+
+void ThreadSafeZMQSubscriber::dispatch(std::string_view topic, zmq::message_t&& body)
+{
+    // libzmq ֻǰ׺ˣExact ĻŽ topicҲֻѾûлصǰ׺
+    bool handled = false;
+    bool default_match = false;
+    topic_trie_.match(topic, [&](uint32_t index, bool exact) {
+        Subscription& subscription = *topic_handlers_[index];
+        if (exact) {
+            subscription.exact_callback(topic, ByteView(body));
+            handled = true;
+            return;
+        }
+        if (subscription.prefix_callback) {
+            subscription.prefix_callback(topic, ByteView(body));
+            handled = true;
+        }
+        default_match = default_match || subscription.default_callback;
+        });
+
+    if (!handled && default_match)
+        dispatch_default(topic, std::move(body));
+}
+
+void ThreadSafeZMQSubscriber::dispatch_default(std::string_view topic, zmq::message_t&& body)
+{
+    if (owned_callback_) {
+        owned_callback_(topic, std::move(body));
+    }
+    else if (view_callback_) {
+        view_callback_(topic, ByteView(body));
+    }
+    else if (message_callback_) {
+        std::vector<uint8_t> data(
+            static_cast<uint8_t*>(body.data()),
+            static_cast<uint8_t*>(body.data()) + body.size()
+        );
+        message_callback_(std::string(topic), data);
+    }
 }
@@ -0,0 +1,51 @@
+#include "TopicTrie.h"
+
+void TopicTrie::build(std::vector<Entry> entries)
+{
+    nodes_.clear();
+    if (entries.empty())
+        return;
+
+    // ǰ׺ͬ key ڣҽ϶̵ key Ϊǰ׺ key ֮ǰstable ֤ظ key һ
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+    nodes_.emplace_back();
+    build_node(0, 0, entries, 0, entries.size());
+    nodes_.shrink_to_fit();
+}
+
+void TopicTrie::build_node(uint32_t node, size_t depth, const std::vector<Entry>& entries, size_t begin, size_t end)
+{
+    // ǡõ˽ key 俪ͷ
+    while (begin < end && entries[begin].key.size() == depth) {
+        nodes_[node].exact = entries[begin].exact;
+        nodes_[node].prefix = entries[begin].prefix;
+        ++begin;
+    }
+    if (begin == end)
+        return;
+
+    // ͳƲһηӽڵ㣬֤
+    size_t child_count = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (i == begin || entries[i].key[depth] != entries[i - 1].key[depth])
+            ++child_count;
+    }
+
+    uint32_t first_child = static_cast<uint32_t>(nodes_.size());
+    nodes_.resize(nodes_.size() + child_count);
+    nodes_[node].first_child = first_child;
+    nodes_[node].child_count = static_cast<uint16_t>(child_count);
+
+    uint32_t child = first_child;
+    size_t group_begin = begin;
+    for (size_t i = begin + 1; i <= end; ++i) {
+        if (i == end || entries[i].key[depth] != entries[group_begin].key[depth]) {
+            nodes_[child].byte = static_cast<uint8_t>(entries[group_begin].key[depth]);
+            build_node(child, depth + 1, entries, group_begin, i);
+            ++child;
+            group_begin = i;
+        }
+    }
+}
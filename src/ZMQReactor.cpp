@@ -0,0 +1,255 @@
+#include "ZMQReactor.h"
+#include "LoggerManager.h"
+#include <algorithm>
+#include <future>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace {
+    constexpr auto kMaxPollTimeout = std::chrono::milliseconds(200);
+
+    void pin_thread(std::thread& thread, int cpu_index)
+    {
+#ifdef _WIN32
+        SetThreadAffinityMask(thread.native_handle(), static_cast<DWORD_PTR>(1) << cpu_index);
+#else
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu_index, &cpu_set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set);
+#endif
+    }
+}
+
+ZMQReactor::ZMQReactor(zmq::context_t& context, int cpu_index)
+    : signaler_(context), items_dirty_(true), running_(true), next_id_(1), cpu_index_(cpu_index), reactor_thread_id_(std::thread::id())
+{
+    reactor_thread_ = std::thread(&ZMQReactor::reactor_loop, this);
+    if (cpu_index_ >= 0) {
+        pin_thread(reactor_thread_, cpu_index_);
+    }
+
+    spdlog::info("[Reactor] Started, cpu: {}", cpu_index_);
+}
+
+ZMQReactor::~ZMQReactor()
+{
+    running_ = false;
+    signaler_.notify();
+    if (reactor_thread_.joinable())
+        reactor_thread_.join();
+
+    spdlog::info("[Reactor] Stopped");
+}
+
+int ZMQReactor::add_socket(zmq::socket_t& socket, short events, SocketHandler handler)
+{
+    int id = next_id_++;
+    void* handle = static_cast<void*>(socket);
+    post([this, id, handle, events, handler = std::move(handler)]() mutable {
+        sockets_.push_back({ id, handle, events, std::move(handler), false });
+        items_dirty_ = true;
+    });
+    return id;
+}
+
+void ZMQReactor::set_events(int id, short events)
+{
+    auto apply = [this, id, events]() {
+        for (auto& entry : sockets_) {
+            if (entry.id == id && entry.events != events) {
+                entry.events = events;
+                items_dirty_ = true;
+            }
+        }
+    };
+
+    if (in_reactor_thread())
+        apply();
+    else
+        post(apply);
+}
+
+void ZMQReactor::remove_socket(int id)
+{
+    // ֻǣɾһ poll ǰУڷַ޸ sockets_
+    call_sync([this, id]() {
+        for (auto& entry : sockets_) {
+            if (entry.id == id) {
+                entry.removed = true;
+                items_dirty_ = true;
+            }
+        }
+    });
+}
+
+int ZMQReactor::add_timer(std::chrono::milliseconds interval, Task task)
+{
+    int id = next_id_++;
+    post([this, id, interval, task = std::move(task)]() mutable {
+        timers_.push_back({ id, interval, std::chrono::steady_clock::now() + interval, std::move(task), false });
+    });
+    return id;
+}
+
+void ZMQReactor::remove_timer(int id)
+{
+    call_sync([this, id]() {
+        for (auto& timer : timers_) {
+            if (timer.id == id)
+                timer.removed = true;
+        }
+    });
+}
+
+void ZMQReactor::post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock(task_mutex_);
+        pending_tasks_.push_back(std::move(task));
+    }
+    signaler_.notify();
+}
+
+bool ZMQReactor::in_reactor_thread() const
+{
+    return std::this_thread::get_id() == reactor_thread_id_.load(std::memory_order_acquire);
+}
+
+void ZMQReactor::call_sync(Task task)
+{
+    if (in_reactor_thread() || !running_) {
+        task();
+        return;
+    }
+
+    std::promise<void> done;
+    auto done_future = done.get_future();
+    post([&task, &done]() {
+        task();
+        done.set_value();
+    });
+    done_future.wait();
+}
+
+void ZMQReactor::run_pending_tasks()
+{
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(task_mutex_);
+        std::swap(tasks, pending_tasks_);
+    }
+
+    for (auto& task : tasks) {
+        task();
+    }
+}
+
+std::chrono::milliseconds ZMQReactor::run_due_timers()
+{
+    auto now = std::chrono::steady_clock::now();
+    auto wait = kMaxPollTimeout;
+
+    // ʱĶʱͨ post 룬ʱ timers_ С
+    for (size_t i = 0; i < timers_.size(); ++i) {
+        if (timers_[i].removed)
+            continue;
+
+        if (now >= timers_[i].next_due) {
+            timers_[i].next_due = now + timers_[i].interval;
+            timers_[i].task();
+        }
+
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(timers_[i].next_due - now);
+        wait = (std::min)(wait, (std::max)(left, std::chrono::milliseconds(0)));
+    }
+
+    timers_.erase(std::remove_if(timers_.begin(), timers_.end(),
+        [](const TimerEntry& timer) { return timer.removed; }), timers_.end());
+
+    return wait;
+}
+
+void ZMQReactor::rebuild_poll_items()
+{
+    sockets_.erase(std::remove_if(sockets_.begin(), sockets_.end(),
+        [](const SocketEntry& entry) { return entry.removed; }), sockets_.end());
+
+    items_.clear();
+    items_.push_back(signaler_.pollitem());
+    for (const auto& entry : sockets_) {
+        zmq::pollitem_t item{};
+        item.socket = entry.handle;
+        item.events = entry.events;
+        items_.push_back(item);
+    }
+    items_dirty_ = false;
+}
+
+void ZMQReactor::reactor_loop()
+{
+    reactor_thread_id_.store(std::this_thread::get_id(), std::memory_order_release);
+
+    while (running_) {
+        run_pending_tasks();
+        auto timeout = run_due_timers();
+
+        if (items_dirty_)
+            rebuild_poll_items();
+
+        try {
+            zmq::poll(items_, timeout);
+        }
+        catch (const zmq::error_t& e) {
+            spdlog::error("[Reactor] Poll failed: {}", e.what());
+            if (e.num() == ETERM)
+                break;
+            continue;
+        }
+
+        if (items_[0].revents & ZMQ_POLLIN)
+            signaler_.consume();
+
+        // items_[i + 1]  sockets_[i] һһӦڵעֻ
+        for (size_t i = 0; i < sockets_.size() && i + 1 < items_.size(); ++i) {
+            short revents = items_[i + 1].revents;
+            if (revents == 0 || sockets_[i].removed)
+                continue;
+
+            try {
+                sockets_[i].handler(revents);
+            }
+            catch (const std::exception& e) {
+                spdlog::error("[Reactor] Handler of socket {} threw: {}", sockets_[i].id, e.what());
+            }
+        }
+    }
+
+    // ˳ǰִʣ񣬱 call_sync ĵ÷һֱȴ
+    run_pending_tasks();
+    spdlog::debug("[Reactor] Reactor_loop exited");
+}
+
+ZMQReactorPool::ZMQReactorPool(zmq::context_t& context, size_t thread_count, bool pin_threads)
+    : next_index_(0)
+{
+    thread_count = (std::max)(thread_count, static_cast<size_t>(1));
+    unsigned int cpu_count = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        int cpu_index = pin_threads ? static_cast<int>(i % cpu_count) : -1;
+        reactors_.push_back(std::make_unique<ZMQReactor>(context, cpu_index));
+    }
+}
+
+ZMQReactor& ZMQReactorPool::next()
+{
+    return *reactors_[next_index_++ % reactors_.size()];
+}
@@ -0,0 +1,53 @@
+#include "ZMQSignaler.h"
+#include "LoggerManager.h"
+
+namespace {
+    std::atomic<unsigned long long> signaler_counter{ 0 };
+}
+
+ZMQSignaler::ZMQSignaler(zmq::context_t& context)
+    : pending_(false)
+{
+    endpoint_ = "inproc://zmq-signaler-" + std::to_string(signaler_counter++);
+
+    reader_ = std::make_unique<zmq::socket_t>(context, ZMQ_PAIR);
+    reader_->set(zmq::sockopt::linger, 0);
+    reader_->bind(endpoint_);
+
+    writer_ = std::make_unique<zmq::socket_t>(context, ZMQ_PAIR);
+    writer_->set(zmq::sockopt::linger, 0);
+    writer_->connect(endpoint_);
+
+    spdlog::debug("[Signaler] Created {}", endpoint_);
+}
+
+ZMQSignaler::~ZMQSignaler()
+{
+    writer_->close();
+    reader_->close();
+}
+
+void ZMQSignaler::notify()
+{
+    if (pending_.exchange(true))
+        return;
+
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    zmq::message_t signal(0);
+    writer_->send(signal, zmq::send_flags::dontwait);
+}
+
+void ZMQSignaler::consume()
+{
+    //  exchange 䵱ȫϣ֤֮Զеļ鲻ᱻŵ֮ǰ
+    pending_.exchange(false);
+
+    zmq::message_t signal;
+    while (reader_->recv(signal, zmq::recv_flags::dontwait)) {
+    }
+}
+
+zmq::pollitem_t ZMQSignaler::pollitem()
+{
+    return { static_cast<void*>(*reader_), 0, ZMQ_POLLIN, 0 };
+}
@@ -3,60 +3,120 @@
 #include "PacketBuilder.h"
 #include "HexUtils.h"
 
-ZMQSocketManager::ZMQSocketManager(ZMQMode mode, const std::string& sendAddress, const std::string& recvAddress, const std::string& topicFilter)
+namespace {
+    std::mutex reactor_pool_mutex;
+
+    //  io_threads 빲 context ״ʹ
+    std::mutex shared_context_mutex;
+    bool shared_context_used = false;
+    int shared_io_threads = 1;
+
+    void warn_if_no_io_thread(const std::string& address) {
+        if (!address.empty() && shared_io_threads == 0 && ZMQEndpoint::uses_io_thread(address))
+            spdlog::error("[ZMQSocketManager] {} needs an I/O thread but io_threads is 0", address);
+    }
+
+    // set_batch_callback ڽ߳µһϢʱһν
+    struct MessageBatch {
+        std::vector<std::string> keys;
+        std::vector<zmq::message_t> messages;
+        std::vector<ReceivedMessage> views;
+    };
+
+    void deliver_batch(MessageBatch& batch, const ZMQSocketManager::BatchCallback& callback) {
+        //  vector ȡͼռݲͼʧЧ
+        batch.views.clear();
+        for (size_t i = 0; i < batch.messages.size(); ++i)
+            batch.views.push_back({ ByteView(reinterpret_cast<const uint8_t*>(batch.keys[i].data()), batch.keys[i].size()), ByteView(batch.messages[i]) });
+        callback(batch.views.data(), batch.views.size());
+        batch.keys.clear();
+        batch.messages.clear();
+    }
+
+    // ֲ̬ڹ֮죬
+    std::unique_ptr<ZMQReactorPool>& reactor_pool() {
+        static std::unique_ptr<ZMQReactorPool> pool;
+        return pool;
+    }
+}
+
+ZMQSocketManager::ZMQSocketManager(ZMQMode mode, const std::string& sendAddress, const std::string& recvAddress, const std::string& topicFilter,
+    const ChannelOptions& options)
     : mode_(mode)
 {
     LoggerManager::Init();
     spdlog::info("[ZMQSocketManager] Construct with mode: {}, send: {}, recv: {}", static_cast<int>(mode), sendAddress, recvAddress);
 
     // ʹù
-    zmq::context_t& context = get_shared_context();
+    zmq::context_t& context = use_shared_context();
+    ZMQReactor* reactor = acquire_reactor();
+    warn_if_no_io_thread(sendAddress);
+    warn_if_no_io_thread(recvAddress);
+
+    if (options.dispatch.threads > 0) {
+        executor_ = std::make_unique<CallbackExecutor>(options.dispatch.threads, options.dispatch.ordering);
+    }
+
+    if (mode != ZMQMode::PushPull && (ZMQEndpoint::transport(sendAddress) == ZMQTransport::SharedMemory
+        || ZMQEndpoint::transport(recvAddress) == ZMQTransport::SharedMemory)) {
+        spdlog::error("[ZMQSocketManager] Shared memory transport only supports PushPull mode");
+        return;
+    }
 
     switch (mode) {
     case ZMQMode::Pair:
         if (!sendAddress.empty()) {
             // bind
-            pair_endpoint_ = std::make_unique<ThreadSafeZMQPair>(context, sendAddress, true);
+            pair_endpoint_ = std::make_unique<ThreadSafeZMQPair>(context, sendAddress, true, reactor, options.send_queue, options.socket);
         }
         else if (!recvAddress.empty()) {
             // connect
-            pair_endpoint_ = std::make_unique<ThreadSafeZMQPair>(context, recvAddress, false);
+            pair_endpoint_ = std::make_unique<ThreadSafeZMQPair>(context, recvAddress, false, reactor, options.send_queue, options.socket);
         }
         break;
 
     case ZMQMode::PubSub:
         if (!sendAddress.empty()) {
-            publisher_ = std::make_unique<ThreadSafeZMQPublisher>(context, sendAddress, true);
+            publisher_ = std::make_unique<ThreadSafeZMQPublisher>(context, sendAddress, true, reactor, options.send_queue, options.socket,
+                options.publisher);
         }
         if (!recvAddress.empty()) {
-            subscriber_ = std::make_unique<ThreadSafeZMQSubscriber>(context, recvAddress, topicFilter, false);
+            subscriber_ = std::make_unique<ThreadSafeZMQSubscriber>(context, recvAddress, topicFilter, false, reactor, options.socket, options.subscriber);
         }
         break;
 
+    // ͬһͨ˶ʱȴ bind ˣPubSub/PushPull  bind ˱ǰ
+    // ֮ͬͨ libzmq 4.x  inproc  connect  bind bind ʱ
     case ZMQMode::ReqRep:
-        if (!sendAddress.empty()) {
-            requester_ = std::make_unique<ThreadSafeZMQRequester>(context, sendAddress);
-        }
         if (!recvAddress.empty()) {
-            replier_ = std::make_unique<ThreadSafeZMQReplier>(context, recvAddress);
+            replier_ = std::make_unique<ThreadSafeZMQReplier>(context, recvAddress, reactor, options.socket);
+        }
+        if (!sendAddress.empty()) {
+            requester_ = std::make_unique<ThreadSafeZMQRequester>(context, sendAddress, reactor, options.send_queue, options.requester, options.socket);
         }
         break;
 
     case ZMQMode::PushPull:
-        if (!sendAddress.empty()) {
-            pusher_ = std::make_unique<ThreadSafeZMQPusher>(context, sendAddress, true);
+        if (ZMQEndpoint::transport(sendAddress) == ZMQTransport::SharedMemory) {
+            shm_pusher_ = std::make_unique<ThreadSafeShmPusher>(context, ZMQEndpoint::path(sendAddress), options.send_queue, options.shm);
         }
-        if (!recvAddress.empty()) {
-            puller_ = std::make_unique<ThreadSafeZMQPuller>(context, recvAddress, false);
+        else if (!sendAddress.empty()) {
+            pusher_ = std::make_unique<ThreadSafeZMQPusher>(context, sendAddress, true, reactor, options.send_queue, options.socket);
+        }
+        if (ZMQEndpoint::transport(recvAddress) == ZMQTransport::SharedMemory) {
+            shm_puller_ = std::make_unique<ThreadSafeShmPuller>(context, ZMQEndpoint::path(recvAddress), reactor, options.shm);
+        }
+        else if (!recvAddress.empty()) {
+            puller_ = std::make_unique<ThreadSafeZMQPuller>(context, recvAddress, false, reactor, options.socket);
         }
         break;
 
     case ZMQMode::DealerRouter:
-        if (!sendAddress.empty()) {
-            dealer_ = std::make_unique<ThreadSafeZMQDealer>(context, sendAddress);
-        }
         if (!recvAddress.empty()) {
-            router_ = std::make_unique<ThreadSafeZMQRouter>(context, recvAddress);
+            router_ = std::make_unique<ThreadSafeZMQRouter>(context, recvAddress, reactor, options.socket, options.router);
+        }
+        if (!sendAddress.empty()) {
+            dealer_ = std::make_unique<ThreadSafeZMQDealer>(context, sendAddress, reactor, options.send_queue, options.socket);
         }
         break;
 
@@ -70,33 +130,132 @@ ZMQSocketManager::~ZMQSocketManager() {
     shutdown();
 }
 
-void ZMQSocketManager::send_async(const std::vector<uint8_t>& data) {
+bool ZMQSocketManager::send_async(const std::vector<uint8_t>& data) {
+    // ڴֱӴӵ÷Ļʡȥм message_t
+    if (mode_ == ZMQMode::PushPull && shm_pusher_) {
+        return shm_pusher_->send_async(data);
+    }
+    return send_async(ZMQMessageUtils::FromBytes(data));
+}
+
+bool ZMQSocketManager::send_async(std::vector<uint8_t>&& data) {
+    return send_async(ZMQMessageUtils::FromBytes(std::move(data)));
+}
+
+bool ZMQSocketManager::send_async(zmq::message_t&& msg) {
     if (mode_ == ZMQMode::Pair && pair_endpoint_) {
-        pair_endpoint_->send_async(data);
+        return pair_endpoint_->send_async(std::move(msg));
     }
     else if (mode_ == ZMQMode::ReqRep && requester_) {
-        requester_->send_request_async(data, [this](const std::vector<uint8_t>& response) {
-            std::lock_guard<std::mutex> lock(callback_mutex_);
-            if (response_callback_) {
-                response_callback_(response);
+        return requester_->send_request_async(std::move(msg), [this](const std::vector<uint8_t>& response) {
+            auto deliver = [this](const std::vector<uint8_t>& data) {
+                std::lock_guard<std::mutex> lock(callback_mutex_);
+                if (response_callback_) {
+                    response_callback_(data);
+                }
+            };
+
+            if (executor_) {
+                executor_->submit(0, [deliver, response]() { deliver(response); });
+            }
+            else {
+                deliver(response);
             }
         });
     }
     else if (mode_ == ZMQMode::PushPull && pusher_) {
-        pusher_->send_async(data);
+        return pusher_->send_async(std::move(msg));
+    }
+    else if (mode_ == ZMQMode::PushPull && shm_pusher_) {
+        return shm_pusher_->send_async(std::move(msg));
     }
     else if (mode_ == ZMQMode::DealerRouter && dealer_) {
-        dealer_->send_async(data);
+        return dealer_->send_async(std::move(msg));
     }
+    return false;
 }
 
-void ZMQSocketManager::send_sub_async(const std::vector<uint8_t>& data, const std::string& topic) {
+bool ZMQSocketManager::send_sub_async(const std::vector<uint8_t>& data, const std::string& topic) {
+    return send_sub_async(ZMQMessageUtils::FromBytes(data), topic);
+}
+
+bool ZMQSocketManager::send_sub_async(std::vector<uint8_t>&& data, const std::string& topic) {
+    return send_sub_async(ZMQMessageUtils::FromBytes(std::move(data)), topic);
+}
+
+bool ZMQSocketManager::send_sub_async(zmq::message_t&& msg, const std::string& topic) {
     if (mode_ == ZMQMode::PubSub && publisher_) {
-        publisher_->publish_async(topic, data);
+        return publisher_->publish_async(topic, std::move(msg));
     }
+    return false;
+}
+
+bool ZMQSocketManager::get_last_value(const std::string& topic, zmq::message_t& out) const {
+    return mode_ == ZMQMode::PubSub && publisher_ && publisher_->last_value(topic, out);
+}
+
+SendQueueStats ZMQSocketManager::get_send_queue_stats() const {
+    if (pair_endpoint_)
+        return pair_endpoint_->queue_stats();
+    if (publisher_)
+        return publisher_->queue_stats();
+    if (requester_)
+        return requester_->queue_stats();
+    if (pusher_)
+        return pusher_->queue_stats();
+    if (shm_pusher_)
+        return shm_pusher_->queue_stats();
+    if (dealer_)
+        return dealer_->queue_stats();
+    return SendQueueStats();
+}
+
+SocketMetricsSnapshot ZMQSocketManager::get_metrics() const {
+    SocketMetricsCollector collector;
+    if (pair_endpoint_)
+        collector.add(pair_endpoint_->metrics());
+    if (publisher_)
+        collector.add(publisher_->metrics());
+    if (subscriber_)
+        collector.add(subscriber_->metrics());
+    if (requester_)
+        collector.add(requester_->metrics());
+    if (replier_)
+        collector.add(replier_->metrics());
+    if (pusher_)
+        collector.add(pusher_->metrics());
+    if (puller_)
+        collector.add(puller_->metrics());
+    if (shm_pusher_)
+        collector.add(shm_pusher_->metrics());
+    if (shm_puller_)
+        collector.add(shm_puller_->metrics());
+    if (dealer_)
+        collector.add(dealer_->metrics());
+    if (router_)
+        collector.add(router_->metrics());
+
+    SocketMetricsSnapshot result = collector.result();
+    SendQueueStats queue_stats = get_send_queue_stats();
+    result.queue_depth = queue_stats.queued;
+    result.dropped = queue_stats.dropped + queue_stats.rejected;
+    if (receive_queue_)
+        result.dropped += receive_queue_->dropped();
+    if (executor_)
+        result.dropped += executor_->dropped();
+    return result;
 }
 
 void ZMQSocketManager::set_callback(std::function<void(const std::vector<uint8_t>&)> callback) {
+    if (executor_ && !requester_) {
+        // ̳߳ģʽͳһȨ汾߳תΪ vector
+        set_message_callback([callback = std::move(callback)](zmq::message_t&& msg) {
+            const uint8_t* data = static_cast<const uint8_t*>(msg.data());
+            callback(std::vector<uint8_t>(data, data + msg.size()));
+            });
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(callback_mutex_);
     if (mode_ == ZMQMode::Pair && pair_endpoint_) {
         pair_endpoint_->set_callback(std::move(callback));
@@ -110,12 +269,23 @@ void ZMQSocketManager::set_callback(std::function<void(const std::vector<uint8_t
     else if (mode_ == ZMQMode::PushPull && puller_) {
         puller_->set_callback(std::move(callback));
     }
+    else if (mode_ == ZMQMode::PushPull && shm_puller_) {
+        shm_puller_->set_callback(std::move(callback));
+    }
     else if (mode_ == ZMQMode::DealerRouter && dealer_) {
         dealer_->set_callback(std::move(callback));
     }
 }
 
 void ZMQSocketManager::set_sub_callback(std::function<void(const std::string& topic, const std::vector<uint8_t>& data)> callback) {
+    if (executor_) {
+        set_sub_message_callback([callback = std::move(callback)](std::string_view topic, zmq::message_t&& msg) {
+            const uint8_t* data = static_cast<const uint8_t*>(msg.data());
+            callback(std::string(topic), std::vector<uint8_t>(data, data + msg.size()));
+            });
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(callback_mutex_);
     if (mode_ == ZMQMode::PubSub && subscriber_) {
         subscriber_->set_callback(std::move(callback));
@@ -123,12 +293,229 @@ void ZMQSocketManager::set_sub_callback(std::function<void(const std::string& to
 }
 
 void ZMQSocketManager::set_router_callback(std::function<void(const std::vector<uint8_t>& id, const std::vector<uint8_t>& data)> callback) {
+    if (executor_) {
+        set_router_message_callback([callback = std::move(callback)](ByteView id, zmq::message_t&& msg) {
+            const uint8_t* data = static_cast<const uint8_t*>(msg.data());
+            callback(id.to_vector(), std::vector<uint8_t>(data, data + msg.size()));
+            });
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(callback_mutex_);
     if (mode_ == ZMQMode::DealerRouter && router_) {
         router_->set_callback(std::move(callback));
     }
 }
 
+void ZMQSocketManager::set_view_callback(std::function<void(ByteView data)> callback) {
+    if (executor_ && !requester_) {
+        set_message_callback([callback = std::move(callback)](zmq::message_t&& msg) { callback(ByteView(msg)); });
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::Pair && pair_endpoint_) {
+        pair_endpoint_->set_view_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::ReqRep && requester_) {
+        // ӦѾ vectorֻװ
+        response_callback_ = [callback = std::move(callback)](const std::vector<uint8_t>& data) { callback(ByteView(data)); };
+    }
+    else if (mode_ == ZMQMode::ReqRep && replier_) {
+        replier_->set_view_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::PushPull && puller_) {
+        puller_->set_view_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::PushPull && shm_puller_) {
+        shm_puller_->set_view_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::DealerRouter && dealer_) {
+        dealer_->set_view_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::set_sub_view_callback(std::function<void(std::string_view topic, ByteView data)> callback) {
+    if (executor_) {
+        set_sub_message_callback([callback = std::move(callback)](std::string_view topic, zmq::message_t&& msg) {
+            callback(topic, ByteView(msg));
+            });
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::PubSub && subscriber_) {
+        subscriber_->set_view_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::set_router_view_callback(std::function<void(ByteView id, ByteView data)> callback) {
+    if (executor_) {
+        set_router_message_callback([callback = std::move(callback)](ByteView id, zmq::message_t&& msg) {
+            callback(id, ByteView(msg));
+            });
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->set_view_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::set_message_callback(std::function<void(zmq::message_t&& msg)> callback) {
+    if (!requester_) {
+        // ˵Ӧ send_async Ͷ
+        callback = dispatched(std::move(callback));
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::Pair && pair_endpoint_) {
+        pair_endpoint_->set_message_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::ReqRep && requester_) {
+        response_callback_ = [callback = std::move(callback)](const std::vector<uint8_t>& data) {
+            callback(ZMQMessageUtils::FromBytes(data));
+        };
+    }
+    else if (mode_ == ZMQMode::ReqRep && replier_) {
+        replier_->set_message_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::PushPull && puller_) {
+        puller_->set_message_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::PushPull && shm_puller_) {
+        shm_puller_->set_message_callback(std::move(callback));
+    }
+    else if (mode_ == ZMQMode::DealerRouter && dealer_) {
+        dealer_->set_message_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::set_sub_message_callback(std::function<void(std::string_view topic, zmq::message_t&& data)> callback) {
+    callback = dispatched_sub(std::move(callback));
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::PubSub && subscriber_) {
+        subscriber_->set_message_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::set_router_message_callback(std::function<void(ByteView id, zmq::message_t&& data)> callback) {
+    callback = dispatched_router(std::move(callback));
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->set_message_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::set_router_handle_callback(ThreadSafeZMQRouter::HandleCallback callback) {
+    if (executor_ && callback) {
+        CallbackExecutor* executor = executor_.get();
+        auto shared_callback = std::make_shared<ThreadSafeZMQRouter::HandleCallback>(std::move(callback));
+        callback = [executor, shared_callback](ThreadSafeZMQRouter::PeerHandle peer, zmq::message_t&& msg) {
+            size_t key = executor->ordering() == DispatchOrdering::PerIdentity ? std::hash<uint32_t>()(peer) : 0;
+            auto owned = std::make_shared<zmq::message_t>(std::move(msg));
+            executor->submit(key, [shared_callback, peer, owned]() { (*shared_callback)(peer, std::move(*owned)); });
+        };
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->set_handle_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::set_batch_callback(BatchCallback callback) {
+    std::function<void()> batch_end;
+    std::shared_ptr<MessageBatch> batch;
+    if (callback) {
+        batch = std::make_shared<MessageBatch>();
+        CallbackExecutor* executor = executor_.get();
+        auto shared_callback = std::make_shared<BatchCallback>(std::move(callback));
+        batch_end = [batch, executor, shared_callback]() {
+            // ֮صʱ batch_end ȻնˣʱûϢ
+            if (batch->messages.empty())
+                return;
+            if (!executor) {
+                deliver_batch(*batch, *shared_callback);
+                return;
+            }
+            auto owned = std::make_shared<MessageBatch>();
+            owned->keys.swap(batch->keys);
+            owned->messages.swap(batch->messages);
+            executor->submit(0, [owned, shared_callback]() { deliver_batch(*owned, *shared_callback); });
+        };
+    }
+
+    // ֱõնˣ dispatchedַ batch_end 
+    std::function<void(std::string_view, zmq::message_t&&)> collect;
+    if (batch) {
+        collect = [batch](std::string_view key, zmq::message_t&& msg) {
+            batch->keys.emplace_back(key);
+            batch->messages.push_back(std::move(msg));
+        };
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (!set_keyed_receiver(std::move(collect), std::move(batch_end)))
+        spdlog::warn("[ZMQSocketManager] Batch callback is not supported in this mode");
+}
+
+ReceiveQueue* ZMQSocketManager::enable_receive_queue(size_t capacity) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (!receive_queue_)
+        receive_queue_ = std::make_unique<ReceiveQueue>(capacity);
+
+    // նڵ I/O ֱ߳ӣǶΨһ
+    ReceiveQueue* queue = receive_queue_.get();
+    if (!set_keyed_receiver([queue](std::string_view key, zmq::message_t&& msg) { queue->push(key, std::move(msg)); }, nullptr)) {
+        spdlog::warn("[ZMQSocketManager] Receive queue is not supported in this mode");
+        return nullptr;
+    }
+    return queue;
+}
+
+bool ZMQSocketManager::set_keyed_receiver(std::function<void(std::string_view key, zmq::message_t&& msg)> callback,
+    std::function<void()> batch_end) {
+    std::function<void(zmq::message_t&&)> plain;
+    std::function<void(ByteView, zmq::message_t&&)> identified;
+    if (callback) {
+        plain = [callback](zmq::message_t&& msg) { callback(std::string_view(), std::move(msg)); };
+        identified = [callback](ByteView id, zmq::message_t&& msg) { callback(id.as_string(), std::move(msg)); };
+    }
+
+    if (mode_ == ZMQMode::Pair && pair_endpoint_) {
+        pair_endpoint_->set_message_callback(std::move(plain));
+        pair_endpoint_->set_batch_end_callback(std::move(batch_end));
+    }
+    else if (mode_ == ZMQMode::PubSub && subscriber_) {
+        subscriber_->set_message_callback(std::move(callback));
+        subscriber_->set_batch_end_callback(std::move(batch_end));
+    }
+    else if (mode_ == ZMQMode::PushPull && puller_) {
+        puller_->set_message_callback(std::move(plain));
+        puller_->set_batch_end_callback(std::move(batch_end));
+    }
+    else if (mode_ == ZMQMode::PushPull && shm_puller_) {
+        shm_puller_->set_message_callback(std::move(plain));
+        shm_puller_->set_batch_end_callback(std::move(batch_end));
+    }
+    else if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->set_message_callback(std::move(identified));
+        router_->set_batch_end_callback(std::move(batch_end));
+    }
+    else if (mode_ == ZMQMode::DealerRouter && dealer_) {
+        dealer_->set_message_callback(std::move(plain));
+        dealer_->set_batch_end_callback(std::move(batch_end));
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
 void ZMQSocketManager::send_replier_reply(const std::vector<uint8_t>& data)
 {
     if (mode_ == ZMQMode::ReqRep && replier_) {
@@ -142,6 +529,101 @@ void ZMQSocketManager::send_router_reply(const std::vector<uint8_t>& id, const s
     }
 }
 
+uint64_t ZMQSocketManager::request_async(const std::vector<uint8_t>& data, ThreadSafeZMQDealer::ReplyCallback callback,
+    std::chrono::milliseconds timeout) {
+    if (mode_ == ZMQMode::DealerRouter && dealer_) {
+        if (executor_ && callback) {
+            CallbackExecutor* executor = executor_.get();
+            auto shared_callback = std::make_shared<ThreadSafeZMQDealer::ReplyCallback>(std::move(callback));
+            callback = [executor, shared_callback](uint64_t request_id, RequestStatus status, ByteView reply) {
+                executor->submit(0, [shared_callback, request_id, status, data = reply.to_vector()]() {
+                    (*shared_callback)(request_id, status, ByteView(data));
+                    });
+            };
+        }
+        return dealer_->request_async(data, std::move(callback), timeout);
+    }
+    return 0;
+}
+
+std::future<DealerReply> ZMQSocketManager::request_async(const std::vector<uint8_t>& data, std::chrono::milliseconds timeout) {
+    if (mode_ == ZMQMode::DealerRouter && dealer_) {
+        return dealer_->request_async(data, timeout);
+    }
+
+    std::promise<DealerReply> promise;
+    DealerReply reply;
+    reply.status = RequestStatus::SendFailed;
+    promise.set_value(std::move(reply));
+    return promise.get_future();
+}
+
+void ZMQSocketManager::set_router_request_callback(ThreadSafeZMQRouter::RequestCallback callback) {
+    if (executor_ && callback) {
+        CallbackExecutor* executor = executor_.get();
+        auto shared_callback = std::make_shared<ThreadSafeZMQRouter::RequestCallback>(std::move(callback));
+        callback = [executor, shared_callback](ByteView id, uint64_t correlation_id, ByteView data) {
+            size_t key = executor->ordering() == DispatchOrdering::PerIdentity ? std::hash<std::string_view>()(id.as_string()) : 0;
+            executor->submit(key, [shared_callback, id = id.to_vector(), correlation_id, data = data.to_vector()]() {
+                (*shared_callback)(ByteView(id), correlation_id, ByteView(data));
+                });
+        };
+    }
+
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->set_request_callback(std::move(callback));
+    }
+}
+
+void ZMQSocketManager::subscribe(const std::string& topic) {
+    if (mode_ == ZMQMode::PubSub && subscriber_) {
+        subscriber_->subscribe(topic);
+    }
+}
+
+void ZMQSocketManager::subscribe(const std::string& topic, ThreadSafeZMQSubscriber::TopicCallback callback, TopicMatch match) {
+    if (executor_ && callback) {
+        // һϢжصתȨͶʱϢ
+        CallbackExecutor* executor = executor_.get();
+        auto shared_callback = std::make_shared<ThreadSafeZMQSubscriber::TopicCallback>(std::move(callback));
+        callback = [executor, shared_callback](std::string_view topic, ByteView data) {
+            size_t key = executor->ordering() == DispatchOrdering::PerTopic ? std::hash<std::string_view>()(topic) : 0;
+            executor->submit(key, [shared_callback, topic = std::string(topic), data = data.to_vector()]() {
+                (*shared_callback)(topic, ByteView(data));
+                });
+        };
+    }
+
+    if (mode_ == ZMQMode::PubSub && subscriber_) {
+        subscriber_->subscribe(topic, std::move(callback), match);
+    }
+}
+
+void ZMQSocketManager::unsubscribe(const std::string& topic) {
+    if (mode_ == ZMQMode::PubSub && subscriber_) {
+        subscriber_->unsubscribe(topic);
+    }
+}
+
+void ZMQSocketManager::send_router_reply(const std::vector<uint8_t>& id, uint64_t correlation_id, const std::vector<uint8_t>& data) {
+    if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->send_to(id, correlation_id, data);
+    }
+}
+
+void ZMQSocketManager::send_router_reply(ThreadSafeZMQRouter::PeerHandle peer, const std::vector<uint8_t>& data) {
+    if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->send_to(peer, data);
+    }
+}
+
+void ZMQSocketManager::send_router_reply(ThreadSafeZMQRouter::PeerHandle peer, uint64_t correlation_id, const std::vector<uint8_t>& data) {
+    if (mode_ == ZMQMode::DealerRouter && router_) {
+        router_->send_to(peer, correlation_id, data);
+    }
+}
+
 void ZMQSocketManager::set_timeout_callback(std::function<void()> callback) {
     std::lock_guard<std::mutex> lock(callback_mutex_);
     timeout_callback_ = std::move(callback);
@@ -158,43 +640,180 @@ void ZMQSocketManager::set_timeout_callback(std::function<void()> callback) {
 }
 
 void ZMQSocketManager::shutdown() {
-    std::lock_guard<std::mutex> lock(callback_mutex_);
-    if (pair_endpoint_) {
+    // ڲִͶݵĻص˵ӦصҪ callback_mutex_
+    // ߳ϵĻصܻͨ socket ظҪ̳ͣ߳ͷ socket
+    // ͷŹնԿյϢЩϢ޷Ͷݣ get_metrics().dropped
+    if (executor_) {
+        executor_->stop();
+    }
+
+    // ֻ socket ȡͷŷŵ⣺ʱ remove_socket/remove_timer Ҫȹ reactor ̣߳
+    // ߳ϵӦص callback_mutex_
+    std::unique_ptr<ThreadSafeZMQPair> pair_endpoint;
+    std::unique_ptr<ThreadSafeZMQRequester> requester;
+    std::unique_ptr<ThreadSafeZMQReplier> replier;
+    std::unique_ptr<ThreadSafeZMQSubscriber> subscriber;
+    std::unique_ptr<ThreadSafeZMQPublisher> publisher;
+    std::unique_ptr<ThreadSafeZMQPuller> puller;
+    std::unique_ptr<ThreadSafeZMQPusher> pusher;
+    std::unique_ptr<ThreadSafeShmPuller> shm_puller;
+    std::unique_ptr<ThreadSafeShmPusher> shm_pusher;
+    std::unique_ptr<ThreadSafeZMQDealer> dealer;
+    std::unique_ptr<ThreadSafeZMQRouter> router;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        pair_endpoint = std::move(pair_endpoint_);
+        requester = std::move(requester_);
+        replier = std::move(replier_);
+        subscriber = std::move(subscriber_);
+        publisher = std::move(publisher_);
+        puller = std::move(puller_);
+        pusher = std::move(pusher_);
+        shm_puller = std::move(shm_puller_);
+        shm_pusher = std::move(shm_pusher_);
+        dealer = std::move(dealer_);
+        router = std::move(router_);
+    }
+
+    if (pair_endpoint) {
         spdlog::debug("[ZMQSocketManager] Releasing pair");
-        pair_endpoint_.reset();
+        pair_endpoint.reset();
     }
-    if (requester_) {
+    if (requester) {
         spdlog::debug("[ZMQSocketManager] Releasing requester");
-        requester_.reset();
+        requester.reset();
     }
-    if (replier_) {
+    if (replier) {
         spdlog::debug("[ZMQSocketManager] Releasing replier");
-        replier_.reset();
+        replier.reset();
     }
-    if (subscriber_) {
+    if (subscriber) {
         spdlog::debug("[ZMQSocketManager] Releasing subscriber");
-        subscriber_.reset();
+        subscriber.reset();
     }
-    if (publisher_) {
+    if (publisher) {
         spdlog::debug("[ZMQSocketManager] Releasing publisher");
-        publisher_.reset();
+        publisher.reset();
     }
-    if (puller_) {
+    if (puller) {
         spdlog::debug("[ZMQSocketManager] Releasing receiver");
-        puller_.reset();
+        puller.reset();
     }
-    if (pusher_) {
+    if (pusher) {
         spdlog::debug("[ZMQSocketManager] Releasing sender");
-        pusher_.reset();
+        pusher.reset();
+    }
+    if (shm_puller) {
+        spdlog::debug("[ZMQSocketManager] Releasing shared memory receiver");
+        shm_puller.reset();
+    }
+    if (shm_pusher) {
+        spdlog::debug("[ZMQSocketManager] Releasing shared memory sender");
+        shm_pusher.reset();
     }
-    if (dealer_) {
+    if (dealer) {
         spdlog::debug("[ZMQSocketManager] Releasing dealer");
-        dealer_.reset();
+        dealer.reset();
     }
-    if (router_) {
+    if (router) {
         spdlog::debug("[ZMQSocketManager] Releasing router");
-        router_.reset();
+        router.reset();
     }
 
+    if (executor_ && executor_->dropped() > 0)
+        spdlog::warn("[ZMQSocketManager] {} messages arrived after dispatch stopped and were dropped", executor_->dropped());
+
     spdlog::debug("[ZMQSocketManager] Shutdown finish");
 }
+
+void ZMQSocketManager::enable_reactor_mode(size_t reactor_threads, bool pin_threads) {
+    LoggerManager::Init();
+    // ȴģ֤ reactor 
+    zmq::context_t& context = use_shared_context();
+
+    std::lock_guard<std::mutex> lock(reactor_pool_mutex);
+    auto& pool = reactor_pool();
+    if (pool) {
+        spdlog::warn("[ZMQSocketManager] Reactor mode already enabled with {} threads", pool->size());
+        return;
+    }
+
+    pool = std::make_unique<ZMQReactorPool>(context, reactor_threads, pin_threads);
+    spdlog::info("[ZMQSocketManager] Reactor mode enabled, threads: {}, pinned: {}", pool->size(), pin_threads);
+}
+
+bool ZMQSocketManager::set_io_threads(int io_threads) {
+    LoggerManager::Init();
+    if (io_threads < 0) {
+        spdlog::error("[ZMQSocketManager] Invalid io_threads: {}", io_threads);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(shared_context_mutex);
+    // libzmq ֻڴһ socket ʱ I/O ̣֮߳ûᱻĬ
+    if (shared_context_used) {
+        spdlog::warn("[ZMQSocketManager] io_threads must be set before any channel is created, keeping {}", shared_io_threads);
+        return false;
+    }
+
+    get_shared_context().set(zmq::ctxopt::io_threads, io_threads);
+    shared_io_threads = io_threads;
+    spdlog::info("[ZMQSocketManager] Shared context io_threads: {}", io_threads);
+    return true;
+}
+
+zmq::context_t& ZMQSocketManager::use_shared_context() {
+    std::lock_guard<std::mutex> lock(shared_context_mutex);
+    shared_context_used = true;
+    return get_shared_context();
+}
+
+std::function<void(zmq::message_t&&)> ZMQSocketManager::dispatched(std::function<void(zmq::message_t&&)> callback) {
+    if (!executor_ || !callback)
+        return callback;
+
+    // û identity/topic  socket ģʽȫ̶ͬһ߳
+    CallbackExecutor* executor = executor_.get();
+    auto shared_callback = std::make_shared<std::function<void(zmq::message_t&&)>>(std::move(callback));
+    return [executor, shared_callback](zmq::message_t&& msg) {
+        // std::function ҪɿϢŽ shared_ptr ת
+        auto owned = std::make_shared<zmq::message_t>(std::move(msg));
+        executor->submit(0, [shared_callback, owned]() { (*shared_callback)(std::move(*owned)); });
+    };
+}
+
+std::function<void(std::string_view, zmq::message_t&&)> ZMQSocketManager::dispatched_sub(std::function<void(std::string_view, zmq::message_t&&)> callback) {
+    if (!executor_ || !callback)
+        return callback;
+
+    CallbackExecutor* executor = executor_.get();
+    auto shared_callback = std::make_shared<std::function<void(std::string_view, zmq::message_t&&)>>(std::move(callback));
+    return [executor, shared_callback](std::string_view topic, zmq::message_t&& msg) {
+        size_t key = executor->ordering() == DispatchOrdering::PerTopic ? std::hash<std::string_view>()(topic) : 0;
+        auto owned = std::make_shared<zmq::message_t>(std::move(msg));
+        executor->submit(key, [shared_callback, topic = std::string(topic), owned]() {
+            (*shared_callback)(topic, std::move(*owned));
+            });
+    };
+}
+
+std::function<void(ByteView, zmq::message_t&&)> ZMQSocketManager::dispatched_router(std::function<void(ByteView, zmq::message_t&&)> callback) {
+    if (!executor_ || !callback)
+        return callback;
+
+    CallbackExecutor* executor = executor_.get();
+    auto shared_callback = std::make_shared<std::function<void(ByteView, zmq::message_t&&)>>(std::move(callback));
+    return [executor, shared_callback](ByteView id, zmq::message_t&& msg) {
+        size_t key = executor->ordering() == DispatchOrdering::PerIdentity ? std::hash<std::string_view>()(id.as_string()) : 0;
+        auto owned = std::make_shared<zmq::message_t>(std::move(msg));
+        executor->submit(key, [shared_callback, id = id.to_vector(), owned]() {
+            (*shared_callback)(ByteView(id), std::move(*owned));
+            });
+    };
+}
+
+ZMQReactor* ZMQSocketManager::acquire_reactor() {
+    std::lock_guard<std::mutex> lock(reactor_pool_mutex);
+    auto& pool = reactor_pool();
+    return pool ? &pool->next() : nullptr;
+}
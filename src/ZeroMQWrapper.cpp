@@ -2,8 +2,133 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
 
 #include "ZeroMQWrapper.h"
+#include "LoggerManager.h"
+
+namespace {
+    ChannelOptions to_channel_options(const ZMQChannelOptions* options) {
+        ChannelOptions result;
+        if (!options)
+            return result;
+        if (options->struct_size == 0) {
+            spdlog::warn("[ZeroMQWrapper] ZMQChannelOptions.struct_size is 0, using default options");
+            return result;
+        }
+
+        // ÷Ľṹܱȱľɣֻ struct_size ǵĲ֣ȱٵβֶΪ 0Ĭֵ
+        size_t provided = options->struct_size;
+        ZMQChannelOptions known;
+        std::memset(&known, 0, sizeof(known));
+        std::memcpy(&known, options, (std::min)(provided, sizeof(known)));
+        options = &known;
+
+        result.send_queue.kind = options->send_queue_kind == 1 ? SendQueueKind::LockFree : SendQueueKind::Mutex;
+        if (options->send_queue_capacity > 0)
+            result.send_queue.capacity = static_cast<size_t>(options->send_queue_capacity);
+        switch (options->send_queue_overflow) {
+        case 1: result.send_queue.overflow = OverflowPolicy::Block; break;
+        case 3: result.send_queue.overflow = OverflowPolicy::DropOldest; break;
+        case 4: result.send_queue.overflow = OverflowPolicy::Fail; break;
+        default: result.send_queue.overflow = OverflowPolicy::DropNewest; break;
+        }
+
+        result.requester.pipelined = options->requester_pipelined != 0;
+        if (options->requester_max_in_flight > 0)
+            result.requester.max_in_flight = static_cast<size_t>(options->requester_max_in_flight);
+        if (options->request_timeout_ms > 0)
+            result.requester.request_timeout = std::chrono::milliseconds(options->request_timeout_ms);
+
+        if (options->dispatch_threads > 0)
+            result.dispatch.threads = static_cast<size_t>(options->dispatch_threads);
+        switch (options->dispatch_ordering) {
+        case 1: result.dispatch.ordering = DispatchOrdering::PerIdentity; break;
+        case 2: result.dispatch.ordering = DispatchOrdering::PerTopic; break;
+        default: result.dispatch.ordering = DispatchOrdering::Unordered; break;
+        }
+
+        if (options->shm_ring_mb > 0)
+            result.shm.ring_bytes = static_cast<size_t>(options->shm_ring_mb) * 1024 * 1024;
+
+        result.publisher.conflate = options->publisher_conflate != 0;
+        result.publisher.last_value_cache = options->publisher_last_value_cache != 0;
+        if (options->publisher_snapshot_address)
+            result.publisher.snapshot_address = options->publisher_snapshot_address;
+        if (options->subscriber_snapshot_address)
+            result.subscriber.snapshot_address = options->subscriber_snapshot_address;
+        if (options->publisher_retransmit_depth > 0)
+            result.publisher.retransmit_depth = static_cast<size_t>(options->publisher_retransmit_depth);
+        result.subscriber.recover_gaps = options->subscriber_recover_gaps != 0;
+        if (options->subscriber_recovery_timeout_ms > 0)
+            result.subscriber.recovery_timeout = std::chrono::milliseconds(options->subscriber_recovery_timeout_ms);
+        if (options->router_identity_capacity > 0)
+            result.router.identity_capacity = static_cast<size_t>(options->router_identity_capacity);
+        return result;
+    }
+
+    std::optional<int> to_option(int value) {
+        return value == ZMQ_SOCKOPT_UNSET ? std::nullopt : std::optional<int>(value);
+    }
+
+    SocketOptions to_socket_options(const ZMQSocketOptions* options) {
+        SocketOptions result;
+        if (!options)
+            return result;
+
+        result.sndhwm = to_option(options->sndhwm);
+        result.rcvhwm = to_option(options->rcvhwm);
+        result.sndbuf = to_option(options->sndbuf);
+        result.rcvbuf = to_option(options->rcvbuf);
+        result.linger = to_option(options->linger_ms);
+        result.sndtimeo = to_option(options->sndtimeo_ms);
+        result.rcvtimeo = to_option(options->rcvtimeo_ms);
+        result.tcp_keepalive = to_option(options->tcp_keepalive);
+        result.tcp_keepalive_idle = to_option(options->tcp_keepalive_idle);
+        result.tcp_keepalive_intvl = to_option(options->tcp_keepalive_intvl);
+        result.tcp_keepalive_cnt = to_option(options->tcp_keepalive_cnt);
+        if (options->immediate != ZMQ_SOCKOPT_UNSET)
+            result.immediate = options->immediate != 0;
+        if (options->affinity != 0)
+            result.affinity = options->affinity;
+        return result;
+    }
+
+    // һϢЧʱֻܾǰ
+    bool valid_batch(const uint8_t** buffers, const int* lengths, int count) {
+        for (int i = 0; i < count; ++i) {
+            if (!buffers[i] || lengths[i] <= 0)
+                return false;
+        }
+        return true;
+    }
+
+    // ÷ struct_size дزѯɵ÷Ľṹֻյʶֶ
+    template <typename T>
+    int write_result(const T& value, T* out) {
+        size_t provided = out->struct_size;
+        if (provided < sizeof(out->struct_size))
+            return ZMQ_RESULT_INVALID_ARGUMENT;
+
+        T sized = value;
+        sized.struct_size = out->struct_size;
+        std::memcpy(out, &sized, (std::min)(provided, sizeof(T)));
+        return ZMQ_RESULT_OK;
+    }
+
+    void to_latency_stats(const LatencySnapshot& snapshot, ZMQLatencyStats& out) {
+        out.count = static_cast<int64_t>(snapshot.count);
+        out.min_ns = static_cast<int64_t>(snapshot.min_ns);
+        out.max_ns = static_cast<int64_t>(snapshot.max_ns);
+        out.mean_ns = static_cast<int64_t>(snapshot.mean_ns);
+        out.p50_ns = static_cast<int64_t>(snapshot.p50_ns);
+        out.p90_ns = static_cast<int64_t>(snapshot.p90_ns);
+        out.p99_ns = static_cast<int64_t>(snapshot.p99_ns);
+        out.p999_ns = static_cast<int64_t>(snapshot.p999_ns);
+    }
+}
 
 extern "C" {
     
@@ -11,36 +136,293 @@ extern "C" {
         return new ZMQSocketManager(mode, send, recv, topic);
     }
 
-    void __stdcall Send(ZMQSocketManager* channel, const uint8_t* data, int length) {
-        if (channel && data && length > 0) {
-            std::vector<uint8_t> vec(data, data + length);
-            channel->send_async(vec);
+    ZMQSocketManager* __stdcall CreateChannelEx(ZMQMode mode, const char* send, const char* recv, const char* topic, const ZMQChannelOptions* options) {
+        return new ZMQSocketManager(mode, send, recv, topic, to_channel_options(options));
+    }
+
+    ZMQSocketManager* __stdcall CreateChannelWithSocketOptions(ZMQMode mode, const char* send, const char* recv, const char* topic,
+        const ZMQChannelOptions* options, const ZMQSocketOptions* socket_options) {
+        ChannelOptions channel_options = to_channel_options(options);
+        channel_options.socket = to_socket_options(socket_options);
+        return new ZMQSocketManager(mode, send, recv, topic, channel_options);
+    }
+
+    void __stdcall InitSocketOptions(ZMQSocketOptions* socket_options) {
+        if (!socket_options)
+            return;
+
+        int* fields[] = {
+            &socket_options->sndhwm, &socket_options->rcvhwm, &socket_options->sndbuf, &socket_options->rcvbuf,
+            &socket_options->linger_ms, &socket_options->sndtimeo_ms, &socket_options->rcvtimeo_ms,
+            &socket_options->tcp_keepalive, &socket_options->tcp_keepalive_idle, &socket_options->tcp_keepalive_intvl,
+            &socket_options->tcp_keepalive_cnt, &socket_options->immediate
+        };
+        for (int* field : fields)
+            *field = ZMQ_SOCKOPT_UNSET;
+        socket_options->affinity = 0;
+    }
+
+    void __stdcall InitChannelOptions(ZMQChannelOptions* options) {
+        if (!options)
+            return;
+
+        std::memset(options, 0, sizeof(ZMQChannelOptions));
+        options->struct_size = static_cast<uint32_t>(sizeof(ZMQChannelOptions));
+    }
+
+    int __stdcall Send(ZMQSocketManager* channel, const uint8_t* data, int length) {
+        if (!channel || !data || length <= 0) {
+            return ZMQ_SEND_INVALID_ARGUMENT;
         }
+
+        // ÷ĻڷغʧЧǷ·Ψһһο
+        return channel->send_async(zmq::message_t(data, static_cast<size_t>(length))) ? ZMQ_SEND_OK : ZMQ_SEND_REJECTED;
     }
 
     void __stdcall RegisterCallback(ZMQSocketManager* channel, MessageCallbackFunction callback) {
         if (channel && callback) {
-            channel->set_callback([=](const std::vector<uint8_t>& data) {
+            // ֱӰѽ֡ڴ潻÷صǰЧ
+            channel->set_view_callback([=](ByteView data) {
                 callback(data.data(), static_cast<int>(data.size()));
                 });
         }
     }
 
-    void __stdcall SendWithTopic(ZMQSocketManager* channel, const uint8_t* data, int length, const char* topic) {
-        if (channel && data && length > 0) {
-            std::vector<uint8_t> vec(data, data + length);
-            channel->send_sub_async(vec, topic);
+    int __stdcall SendWithTopic(ZMQSocketManager* channel, const uint8_t* data, int length, const char* topic) {
+        if (!channel || !data || length <= 0) {
+            return ZMQ_SEND_INVALID_ARGUMENT;
+        }
+
+        return channel->send_sub_async(zmq::message_t(data, static_cast<size_t>(length)), topic ? topic : "") ? ZMQ_SEND_OK : ZMQ_SEND_REJECTED;
+    }
+
+    int __stdcall SendBatch(ZMQSocketManager* channel, const uint8_t** buffers, const int* lengths, int count) {
+        if (!channel || !buffers || !lengths || count < 0 || !valid_batch(buffers, lengths, count)) {
+            return ZMQ_SEND_INVALID_ARGUMENT;
+        }
+
+        int sent = 0;
+        while (sent < count && channel->send_async(zmq::message_t(buffers[sent], static_cast<size_t>(lengths[sent]))))
+            ++sent;
+        return sent;
+    }
+
+    int __stdcall SendBatchWithTopic(ZMQSocketManager* channel, const uint8_t** buffers, const int* lengths, int count, const char* topic) {
+        if (!channel || !buffers || !lengths || count < 0 || !valid_batch(buffers, lengths, count)) {
+            return ZMQ_SEND_INVALID_ARGUMENT;
+        }
+
+        std::string topic_str(topic ? topic : "");
+        int sent = 0;
+        while (sent < count && channel->send_sub_async(zmq::message_t(buffers[sent], static_cast<size_t>(lengths[sent])), topic_str))
+            ++sent;
+        return sent;
+    }
+
+    int __stdcall EnablePullMode(ZMQSocketManager* channel, int capacity) {
+        if (!channel) {
+            return ZMQ_RESULT_INVALID_ARGUMENT;
+        }
+
+        ReceiveQueue* queue = capacity > 0 ? channel->enable_receive_queue(static_cast<size_t>(capacity)) : channel->enable_receive_queue();
+        if (!queue) {
+            return ZMQ_RESULT_NOT_SUPPORTED;
         }
+        return ZMQ_RESULT_OK;
+    }
+
+    int __stdcall TryReceive(ZMQSocketManager* channel, uint8_t* buffer, int capacity, int* length,
+        uint8_t* key, int key_capacity, int* key_length) {
+        if (!channel || !length || (!buffer && capacity > 0) || (!key && key_capacity > 0)) {
+            return ZMQ_RESULT_INVALID_ARGUMENT;
+        }
+
+        ReceiveQueue* queue = channel->receive_queue();
+        if (!queue) {
+            return ZMQ_RECV_NOT_ENABLED;
+        }
+
+        ReceiveQueue::Entry* entry = queue->front();
+        if (!entry) {
+            return ZMQ_RECV_EMPTY;
+        }
+
+        *length = static_cast<int>(entry->data.size());
+        if (key_length)
+            *key_length = static_cast<int>(entry->key.size());
+        if (entry->data.size() > static_cast<size_t>((std::max)(capacity, 0))
+            || (key && entry->key.size() > static_cast<size_t>(key_capacity))) {
+            return ZMQ_RECV_BUFFER_TOO_SMALL;
+        }
+
+        if (!entry->data.empty())
+            std::memcpy(buffer, entry->data.data(), entry->data.size());
+        if (key && !entry->key.empty())
+            std::memcpy(key, entry->key.data(), entry->key.size());
+        queue->pop();
+        return 1;
+    }
+
+    int __stdcall ReceiveMany(ZMQSocketManager* channel, uint8_t* buffer, int capacity,
+        ZMQMessageView* messages, int max_messages, int timeout_ms) {
+        if (!channel || !buffer || capacity <= 0 || !messages || max_messages <= 0) {
+            return ZMQ_RESULT_INVALID_ARGUMENT;
+        }
+
+        ReceiveQueue* queue = channel->receive_queue();
+        if (!queue) {
+            return ZMQ_RECV_NOT_ENABLED;
+        }
+
+        if (!queue->wait(std::chrono::milliseconds(timeout_ms))) {
+            return ZMQ_RECV_EMPTY;
+        }
+
+        // key ݺ棬ͬһ黺
+        size_t used = 0;
+        int count = 0;
+        while (count < max_messages) {
+            ReceiveQueue::Entry* entry = queue->front();
+            if (!entry)
+                break;
+
+            size_t needed = entry->data.size() + entry->key.size();
+            if (used + needed > static_cast<size_t>(capacity)) {
+                if (count == 0)
+                    return ZMQ_RECV_BUFFER_TOO_SMALL;
+                break;
+            }
+
+            ZMQMessageView& view = messages[count];
+            view.data = buffer + used;
+            view.length = static_cast<int>(entry->data.size());
+            if (!entry->data.empty())
+                std::memcpy(buffer + used, entry->data.data(), entry->data.size());
+            used += entry->data.size();
+
+            view.key = buffer + used;
+            view.key_length = static_cast<int>(entry->key.size());
+            if (!entry->key.empty())
+                std::memcpy(buffer + used, entry->key.data(), entry->key.size());
+            used += entry->key.size();
+
+            queue->pop();
+            ++count;
+        }
+        return count;
+    }
+
+    intptr_t __stdcall GetReadyHandle(ZMQSocketManager* channel) {
+        ReceiveQueue* queue = channel ? channel->receive_queue() : nullptr;
+        return queue ? queue->ready_handle() : -1;
+    }
+
+    void __stdcall RegisterBatchCallback(ZMQSocketManager* channel, BatchCallbackFunction callback) {
+        if (channel && callback) {
+            channel->set_batch_callback([=](const ReceivedMessage* messages, size_t count) {
+                //  dispatch ʱ߳̿ͬʱصתõ鰴̸߳Ը
+                thread_local std::vector<ZMQMessageView> views;
+                views.resize(count);
+                for (size_t i = 0; i < count; ++i) {
+                    views[i].data = messages[i].data.data();
+                    views[i].length = static_cast<int>(messages[i].data.size());
+                    views[i].key = messages[i].key.data();
+                    views[i].key_length = static_cast<int>(messages[i].key.size());
+                }
+                callback(views.data(), static_cast<int>(count));
+                });
+        }
+    }
+
+    int __stdcall GetSendQueueStats(ZMQSocketManager* channel, ZMQSendQueueStats* stats) {
+        if (!channel || !stats) {
+            return ZMQ_RESULT_INVALID_ARGUMENT;
+        }
+
+        SendQueueStats queue_stats = channel->get_send_queue_stats();
+        ZMQSendQueueStats result;
+        std::memset(&result, 0, sizeof(result));
+        result.queued = static_cast<int64_t>(queue_stats.queued);
+        result.dropped = static_cast<int64_t>(queue_stats.dropped);
+        result.rejected = static_cast<int64_t>(queue_stats.rejected);
+        result.replaced = static_cast<int64_t>(queue_stats.replaced);
+        return write_result(result, stats);
+    }
+
+    int __stdcall GetLastValue(ZMQSocketManager* channel, const char* topic, uint8_t* buffer, int capacity, int* length) {
+        if (!channel || !topic || !length || (!buffer && capacity > 0)) {
+            return ZMQ_RESULT_INVALID_ARGUMENT;
+        }
+
+        zmq::message_t value;
+        if (!channel->get_last_value(topic, value)) {
+            return ZMQ_RECV_EMPTY;
+        }
+
+        *length = static_cast<int>(value.size());
+        if (value.size() > static_cast<size_t>((std::max)(capacity, 0))) {
+            return ZMQ_RECV_BUFFER_TOO_SMALL;
+        }
+        if (value.size() > 0)
+            std::memcpy(buffer, value.data(), value.size());
+        return 1;
+    }
+
+    int __stdcall GetChannelMetrics(ZMQSocketManager* channel, ZMQChannelMetrics* metrics) {
+        if (!channel || !metrics) {
+            return ZMQ_RESULT_INVALID_ARGUMENT;
+        }
+
+        SocketMetricsSnapshot snapshot = channel->get_metrics();
+        ZMQChannelMetrics result;
+        std::memset(&result, 0, sizeof(result));
+        result.messages_sent = static_cast<int64_t>(snapshot.messages_sent);
+        result.bytes_sent = static_cast<int64_t>(snapshot.bytes_sent);
+        result.messages_received = static_cast<int64_t>(snapshot.messages_received);
+        result.bytes_received = static_cast<int64_t>(snapshot.bytes_received);
+        result.send_failures = static_cast<int64_t>(snapshot.send_failures);
+        result.dropped = static_cast<int64_t>(snapshot.dropped);
+        result.retries = static_cast<int64_t>(snapshot.retries);
+        result.timeouts = static_cast<int64_t>(snapshot.timeouts);
+        result.queue_depth = static_cast<int64_t>(snapshot.queue_depth);
+        result.queue_high_water = static_cast<int64_t>(snapshot.queue_high_water);
+        to_latency_stats(snapshot.enqueue_to_wire, result.enqueue_to_wire);
+        to_latency_stats(snapshot.callback_duration, result.callback_duration);
+        result.lost = static_cast<int64_t>(snapshot.lost);
+        return write_result(result, metrics);
     }
 
     void __stdcall RegisterSubCallback(ZMQSocketManager* channel, SubMessageCallbackFunction callback) {
         if (channel && callback) {
-            channel->set_sub_callback([=](const std::string& topic, const std::vector<uint8_t>& data) {
-                callback(topic.c_str(), data.data(), static_cast<int>(data.size()));
+            channel->set_sub_view_callback([=](std::string_view topic, ByteView data) {
+                // topic ֡ '\0' βֻһС
+                std::string topic_str(topic);
+                callback(topic_str.c_str(), data.data(), static_cast<int>(data.size()));
                 });
         }
     }
 
+    void __stdcall Subscribe(ZMQSocketManager* channel, const char* topic) {
+        if (channel && topic) {
+            channel->subscribe(topic);
+        }
+    }
+
+    void __stdcall SubscribeWithCallback(ZMQSocketManager* channel, const char* topic, int exact, SubMessageCallbackFunction callback) {
+        if (channel && topic && callback) {
+            channel->subscribe(topic, [=](std::string_view topic, ByteView data) {
+                std::string topic_str(topic);
+                callback(topic_str.c_str(), data.data(), static_cast<int>(data.size()));
+                }, exact != 0 ? TopicMatch::Exact : TopicMatch::Prefix);
+        }
+    }
+
+    void __stdcall Unsubscribe(ZMQSocketManager* channel, const char* topic) {
+        if (channel && topic) {
+            channel->unsubscribe(topic);
+        }
+    }
+
     void __stdcall SendReplierReply(ZMQSocketManager* channel, const uint8_t* data, int length) {
         if (channel && data && length > 0) {
             std::vector<uint8_t> vec(data, data + length);
@@ -50,7 +432,7 @@ extern "C" {
 
     void __stdcall RegisterRouterCallback(ZMQSocketManager* channel, RouterMessageCallbackFunction callback) {
         if (channel && callback) {
-            channel->set_router_callback([=](const std::vector<uint8_t>& identity, const std::vector<uint8_t>& data) {
+            channel->set_router_view_callback([=](ByteView identity, ByteView data) {
                 callback(identity.data(), static_cast<int>(identity.size()), data.data(), static_cast<int>(data.size()));
                 });
         }
@@ -68,6 +450,60 @@ extern "C" {
         channel->send_router_reply(id_vec, data_vec);
     }
 
+    int64_t __stdcall SendRequest(ZMQSocketManager* channel, const uint8_t* data, int length, int timeout_ms, ReplyCallbackFunction callback) {
+        if (!channel || !data || length <= 0 || !callback) {
+            return ZMQ_SEND_INVALID_ARGUMENT;
+        }
+
+        uint64_t id = channel->request_async(std::vector<uint8_t>(data, data + length),
+            [=](uint64_t request_id, RequestStatus status, ByteView reply) {
+                callback(static_cast<int64_t>(request_id), static_cast<int>(status), reply.data(), static_cast<int>(reply.size()));
+            },
+            timeout_ms > 0 ? std::chrono::milliseconds(timeout_ms) : ThreadSafeZMQDealer::kDefaultRequestTimeout);
+        if (id == 0) {
+            return ZMQ_SEND_REJECTED;
+        }
+        return static_cast<int64_t>(id);
+    }
+
+    void __stdcall RegisterRouterRequestCallback(ZMQSocketManager* channel, RouterRequestCallbackFunction callback) {
+        if (channel && callback) {
+            channel->set_router_request_callback([=](ByteView identity, uint64_t correlation_id, ByteView data) {
+                callback(identity.data(), static_cast<int>(identity.size()), static_cast<int64_t>(correlation_id),
+                    data.data(), static_cast<int>(data.size()));
+                });
+        }
+    }
+
+    void __stdcall SendRouterCorrelatedReply(ZMQSocketManager* channel, const uint8_t* identity, int id_len, int64_t correlation_id, const uint8_t* data, int data_len)
+    {
+        if (!channel || !identity || id_len <= 0 || correlation_id <= 0 || !data || data_len < 0) {
+            return;
+        }
+
+        std::vector<uint8_t> id_vec(identity, identity + id_len);
+        std::vector<uint8_t> data_vec(data, data + data_len);
+
+        channel->send_router_reply(id_vec, static_cast<uint64_t>(correlation_id), data_vec);
+    }
+
+    void __stdcall RegisterRouterPeerCallback(ZMQSocketManager* channel, RouterPeerCallbackFunction callback) {
+        if (channel && callback) {
+            channel->set_router_handle_callback([=](uint32_t peer, zmq::message_t&& data) {
+                callback(peer, static_cast<const uint8_t*>(data.data()), static_cast<int>(data.size()));
+                });
+        }
+    }
+
+    void __stdcall SendRouterPeerReply(ZMQSocketManager* channel, uint32_t peer, const uint8_t* data, int data_len)
+    {
+        if (!channel || peer == RouterIdentityTable::kInvalidHandle || !data || data_len <= 0) {
+            return;
+        }
+
+        channel->send_router_reply(peer, std::vector<uint8_t>(data, data + data_len));
+    }
+
     void __stdcall DestroyChannel(ZMQSocketManager* channel) {
         if (channel) {
             delete channel;
@@ -75,4 +511,26 @@ extern "C" {
         }
     }
 
+    void __stdcall EnableReactorMode(int reactor_threads, int pin_threads) {
+        ZMQSocketManager::enable_reactor_mode(reactor_threads > 0 ? static_cast<size_t>(reactor_threads) : 1, pin_threads != 0);
+    }
+
+    int __stdcall SetIOThreads(int io_threads) {
+        return ZMQSocketManager::set_io_threads(io_threads) ? 0 : -1;
+    }
+
+    void __stdcall ConfigureLogging(int async, int queue_size, int sample_rate) {
+        LoggerOptions options;
+        options.async = async != 0;
+        if (queue_size > 0)
+            options.async_queue_size = static_cast<size_t>(queue_size);
+        if (options.async)
+            options.flush_level = spdlog::level::warn;
+        options.sample_rate = sample_rate > 1 ? static_cast<uint32_t>(sample_rate) : 1;
+
+        LoggerManager::Init(options);
+        // Ѿʼʱֻܵ
+        LoggerManager::SetSampleRate(options.sample_rate);
+    }
+
 }